@@ -0,0 +1,145 @@
+/*
+ * Naive dispatch baselines for the SS_Lib benchmarks
+ *
+ * Three ways to call a handler without the library, from cheapest to the
+ * closest match for ss_emit:
+ *
+ *   function pointer array  handlers[id](data, user_data)
+ *   switch dispatch         switch (id) with a direct call per case
+ *   name hash dispatch      FNV-1a over the name, open addressing, then
+ *                           every slot on the entry, in connection order
+ *
+ * All three take the same slot signature and a prebuilt ss_data_t, so the
+ * gap to ss_emit is lookup, locking, instrumentation and the emit path
+ * itself; the typed helpers (ss_emit_int, ...) add ss_data_t construction.
+ * No locking, priorities, deferred removal or error reporting here.
+ */
+
+#ifndef BASELINES_H
+#define BASELINES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "ss_lib.h"
+
+#define BASELINE_SIGNALS 16       /* Power of two; switch cases below match */
+#define BASELINE_HASH_SIZE 64     /* Power of two, load factor <= 1/4 */
+#define BASELINE_MAX_SLOTS 4
+
+/* Function pointer array: one handler per signal id */
+typedef struct {
+    ss_slot_func_t handlers[BASELINE_SIGNALS];
+    void* user_data[BASELINE_SIGNALS];
+} baseline_table_t;
+
+static inline void baseline_table_emit(const baseline_table_t* table,
+                                       unsigned id, const ss_data_t* data) {
+    id &= BASELINE_SIGNALS - 1;
+    table->handlers[id](data, table->user_data[id]);
+}
+
+/* Switch dispatch: the compiler sees every target */
+#define BASELINE_SLOT(n) \
+    static void baseline_slot_##n(const ss_data_t* data, void* user_data) { \
+        *(int*)user_data += data->value.i_val + (n); \
+    }
+BASELINE_SLOT(0) BASELINE_SLOT(1) BASELINE_SLOT(2) BASELINE_SLOT(3)
+BASELINE_SLOT(4) BASELINE_SLOT(5) BASELINE_SLOT(6) BASELINE_SLOT(7)
+BASELINE_SLOT(8) BASELINE_SLOT(9) BASELINE_SLOT(10) BASELINE_SLOT(11)
+BASELINE_SLOT(12) BASELINE_SLOT(13) BASELINE_SLOT(14) BASELINE_SLOT(15)
+#undef BASELINE_SLOT
+
+/* The same handlers, for the table, the hash and the library to connect */
+static const ss_slot_func_t baseline_slots[BASELINE_SIGNALS] = {
+    baseline_slot_0, baseline_slot_1, baseline_slot_2, baseline_slot_3,
+    baseline_slot_4, baseline_slot_5, baseline_slot_6, baseline_slot_7,
+    baseline_slot_8, baseline_slot_9, baseline_slot_10, baseline_slot_11,
+    baseline_slot_12, baseline_slot_13, baseline_slot_14, baseline_slot_15
+};
+
+static inline void baseline_switch_emit(unsigned id, const ss_data_t* data,
+                                        void* user_data) {
+    switch (id & (BASELINE_SIGNALS - 1)) {
+    case 0: baseline_slot_0(data, user_data); break;
+    case 1: baseline_slot_1(data, user_data); break;
+    case 2: baseline_slot_2(data, user_data); break;
+    case 3: baseline_slot_3(data, user_data); break;
+    case 4: baseline_slot_4(data, user_data); break;
+    case 5: baseline_slot_5(data, user_data); break;
+    case 6: baseline_slot_6(data, user_data); break;
+    case 7: baseline_slot_7(data, user_data); break;
+    case 8: baseline_slot_8(data, user_data); break;
+    case 9: baseline_slot_9(data, user_data); break;
+    case 10: baseline_slot_10(data, user_data); break;
+    case 11: baseline_slot_11(data, user_data); break;
+    case 12: baseline_slot_12(data, user_data); break;
+    case 13: baseline_slot_13(data, user_data); break;
+    case 14: baseline_slot_14(data, user_data); break;
+    default: baseline_slot_15(data, user_data); break;
+    }
+}
+
+/* Name hash dispatch: the smallest name-keyed design worth comparing */
+typedef struct {
+    const char* name;             /* Not copied; NULL = empty bucket */
+    uint32_t hash;
+    size_t slot_count;
+    ss_slot_func_t slots[BASELINE_MAX_SLOTS];
+    void* user_data[BASELINE_MAX_SLOTS];
+} baseline_hash_entry_t;
+
+typedef struct {
+    baseline_hash_entry_t buckets[BASELINE_HASH_SIZE];
+} baseline_hash_t;
+
+static inline uint32_t baseline_hash_name(const char* name) {
+    uint32_t h = 2166136261u;
+    while (*name) {
+        h ^= (unsigned char)*name++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static inline baseline_hash_entry_t* baseline_hash_find(baseline_hash_t* table,
+                                                        const char* name,
+                                                        int insert) {
+    uint32_t hash = baseline_hash_name(name);
+    size_t i = hash & (BASELINE_HASH_SIZE - 1);
+    for (size_t probes = 0; probes < BASELINE_HASH_SIZE; probes++) {
+        baseline_hash_entry_t* e = &table->buckets[i];
+        if (!e->name) {
+            if (!insert) return NULL;
+            e->name = name;
+            e->hash = hash;
+            return e;
+        }
+        if (e->hash == hash && strcmp(e->name, name) == 0) return e;
+        i = (i + 1) & (BASELINE_HASH_SIZE - 1);
+    }
+    return NULL;
+}
+
+static inline int baseline_hash_connect(baseline_hash_t* table,
+                                        const char* name, ss_slot_func_t slot,
+                                        void* user_data) {
+    baseline_hash_entry_t* e = baseline_hash_find(table, name, 1);
+    if (!e || e->slot_count >= BASELINE_MAX_SLOTS) return -1;
+    e->slots[e->slot_count] = slot;
+    e->user_data[e->slot_count] = user_data;
+    e->slot_count++;
+    return 0;
+}
+
+static inline int baseline_hash_emit(baseline_hash_t* table, const char* name,
+                                     const ss_data_t* data) {
+    baseline_hash_entry_t* e = baseline_hash_find(table, name, 0);
+    if (!e) return -1;
+    for (size_t i = 0; i < e->slot_count; i++) {
+        e->slots[i](data, e->user_data[i]);
+    }
+    return 0;
+}
+
+#endif /* BASELINES_H */
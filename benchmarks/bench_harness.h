@@ -0,0 +1,710 @@
+/*
+ * Benchmark harness shared by the SS_Lib benchmarks
+ *
+ * Usage:
+ *   #define BENCH_HARNESS_IMPLEMENTATION
+ *   #include "bench_harness.h"
+ *
+ * Include it before any system header so CPU pinning is available on
+ * Linux. On Linux the process also re-executes itself once with address
+ * space randomization off: otherwise code and heap placement changes
+ * from one run to the next and moves hot loops by 20% or more. Each case runs its operation `iterations` times per call; the
+ * harness picks `iterations` so one timed batch lasts at least
+ * --min-batch-ns, warms the case up, then times --runs runs of --samples
+ * batches each. Results are reported per operation:
+ *
+ *   median / MAD  median of the per-run medians and the median absolute
+ *                 deviation of those medians (run-to-run noise)
+ *   p50/p99/p99.9 percentiles over every batch of every run. A batch is
+ *                 a mean over many operations, so the tail shows
+ *                 interference (preemption, migrations, frequency
+ *                 changes) rather than the cost of one slow call.
+ *   counters      on Linux, hardware counters from perf_event_open
+ *                 (instructions, cycles, L1D and LLC misses, branch
+ *                 misses) per operation, from one extra run of --samples
+ *                 batches counted in user space only. Counters that cannot
+ *                 be opened (no PMU in a VM, perf_event_paranoid,
+ *                 seccomp) are reported as unavailable and timing goes on.
+ *
+ * Command line (every benchmark built on the harness accepts these):
+ *   --runs=N --samples=N --min-batch-ns=N --warmup-ms=N
+ *   --cpu=N | --no-pin     pin to CPU N (default: the current CPU)
+ *   --aslr                 keep address space randomization on
+ *   --json=PATH            write results as JSON (compare_results.py)
+ *   --filter=TEXT          only run cases whose name contains TEXT
+ *   --quick                3 runs x 100 samples, 5 ms warmup
+ *   --no-counters          skip the hardware counter run
+ */
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BENCH_MAX_RESULTS 64
+#define BENCH_MAX_INFO 16
+
+typedef enum {
+    BENCH_COUNTER_INSTRUCTIONS,
+    BENCH_COUNTER_CYCLES,
+    BENCH_COUNTER_L1D_MISSES,
+    BENCH_COUNTER_LLC_MISSES,
+    BENCH_COUNTER_BRANCH_MISSES,
+    BENCH_COUNTER_COUNT
+} bench_counter_t;
+
+static const char* const bench_counter_names[BENCH_COUNTER_COUNT] = {
+    "instructions", "cycles", "l1d_misses", "llc_misses", "branch_misses"
+};
+
+typedef struct {
+    const char* name;
+    // Optional, untimed: prepare state for `iterations` operations
+    void (*setup)(void* ctx, uint64_t iterations);
+    // Timed: perform `iterations` operations
+    void (*run)(void* ctx, uint64_t iterations);
+    // Optional, untimed: undo what run() left behind
+    void (*teardown)(void* ctx, uint64_t iterations);
+    void* ctx;
+    uint64_t max_batch;          // Cap on iterations per batch, 0 = none
+} bench_case_t;
+
+typedef struct {
+    char name[64];
+    uint64_t batch_iterations;   // Calibrated operations per batch
+    int runs;
+    size_t samples;              // Batches timed over all runs
+    double median_ns;
+    double mad_ns;
+    double mean_ns;
+    double min_ns;
+    double max_ns;
+    double p50_ns;
+    double p99_ns;
+    double p999_ns;
+    double counters[BENCH_COUNTER_COUNT];  // Per operation, < 0 = unavailable
+} bench_result_t;
+
+typedef struct {
+    int runs;
+    int samples;
+    uint64_t min_batch_ns;
+    uint64_t warmup_ns;
+    int cpu;                     // -1 = do not pin
+    int keep_aslr;
+    int no_counters;
+    const char* json_path;
+    const char* filter;
+} bench_options_t;
+
+typedef struct {
+    const char* name;
+    bench_options_t options;
+    int pinned_cpu;              // -1 when pinning failed or was disabled
+    int aslr;                    // Address space randomization still on
+    double clock_overhead_ns;
+    int counter_fds[BENCH_COUNTER_COUNT];          // -1 when not open
+    double counter_overhead[BENCH_COUNTER_COUNT];  // Per counted batch
+    char counter_status[96];     // Why counters are off, when they are
+    bench_result_t results[BENCH_MAX_RESULTS];
+    size_t count;
+    const char* info_keys[BENCH_MAX_INFO];
+    char info_values[BENCH_MAX_INFO][64];
+    size_t info_count;
+} bench_suite_t;
+
+// Parse options, turn off ASLR (may re-execute the program, so call it
+// before printing anything), pin the CPU and measure clock overhead.
+// Returns 0 on success, or -1 after printing usage for an unknown option.
+int bench_suite_init(bench_suite_t* suite, const char* name, int argc,
+                     char** argv);
+
+// Print the harness settings as indented "Configuration:" lines
+void bench_suite_print_config(const bench_suite_t* suite);
+
+// Record a configuration fact ("memory" = "dynamic") for the JSON header
+void bench_suite_info(bench_suite_t* suite, const char* key, const char* value);
+
+// Calibrate, warm up and time one case, then print its line. Returns NULL
+// when the case is filtered out or the result table is full.
+const bench_result_t* bench_suite_run(bench_suite_t* suite,
+                                      const bench_case_t* bench);
+
+// Write JSON if requested. Returns 0 on success.
+int bench_suite_finish(bench_suite_t* suite);
+
+uint64_t bench_now_ns(void);
+
+#ifdef BENCH_HARNESS_IMPLEMENTATION
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <errno.h>
+#include <sched.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/personality.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define BENCH_DEFAULT_RUNS 5
+#define BENCH_DEFAULT_SAMPLES 1000
+#define BENCH_DEFAULT_MIN_BATCH_NS 10000
+#define BENCH_DEFAULT_WARMUP_NS 50000000ULL
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int bench_compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Linear interpolation between closest ranks; `sorted` must be ascending
+static double bench_percentile(const double* sorted, size_t n, double p) {
+    double rank, frac;
+    size_t lo;
+    if (n == 0) return 0.0;
+    rank = p / 100.0 * (double)(n - 1);
+    lo = (size_t)rank;
+    if (lo + 1 >= n) return sorted[n - 1];
+    frac = rank - (double)lo;
+    return sorted[lo] + (sorted[lo + 1] - sorted[lo]) * frac;
+}
+
+// Sorts `values` in place
+static double bench_median(double* values, size_t n) {
+    qsort(values, n, sizeof(double), bench_compare_double);
+    return bench_percentile(values, n, 50.0);
+}
+
+static int bench_pin(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    if (cpu < 0) return -1;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0 ? cpu : -1;
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+// Median cost of one back-to-back pair of clock reads
+static double bench_clock_overhead(void) {
+    double deltas[1001];
+    for (int i = 0; i < 1001; i++) {
+        uint64_t a = bench_now_ns();
+        uint64_t b = bench_now_ns();
+        deltas[i] = (double)(b - a);
+    }
+    return bench_median(deltas, 1001);
+}
+
+// Returns 1 if randomization is still on. Only returns after a failed
+// re-exec, or when the personality cannot be changed (e.g. seccomp).
+static int bench_disable_aslr(char** argv, int keep) {
+#ifdef __linux__
+    int persona = personality(0xffffffff);
+    if (persona == -1) return 1;
+    if (persona & ADDR_NO_RANDOMIZE) return 0;
+    if (keep) return 1;
+    if (personality((unsigned long)persona | ADDR_NO_RANDOMIZE) == -1) return 1;
+    execv("/proc/self/exe", argv);
+    personality((unsigned long)persona);
+#else
+    (void)argv;
+    (void)keep;
+#endif
+    return 1;
+}
+
+#ifdef __linux__
+static int bench_perf_open(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;     // Allowed at perf_event_paranoid 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+#define BENCH_HW_CACHE(cache) \
+    ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | \
+     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+// Scaled count since the last reset, or -1 if the event never ran
+static double bench_counter_read(int fd) {
+    uint64_t v[3];
+    if (read(fd, v, sizeof(v)) != (ssize_t)sizeof(v) || v[2] == 0) return -1.0;
+    // Multiplexed with other events: extrapolate to the enabled time
+    return (double)v[0] * ((double)v[1] / (double)v[2]);
+}
+#endif
+
+static void bench_counters_set(const bench_suite_t* suite, unsigned long op) {
+#ifdef __linux__
+    for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+        if (suite->counter_fds[c] >= 0) ioctl(suite->counter_fds[c], op, 0);
+    }
+#else
+    (void)suite;
+    (void)op;
+#endif
+}
+
+// One counted batch; `out` receives raw counts, -1 where unavailable
+static void bench_counted_batch(const bench_suite_t* suite,
+                                const bench_case_t* bench,
+                                uint64_t iterations, double* out) {
+    if (bench && bench->setup) bench->setup(bench->ctx, iterations);
+#ifdef __linux__
+    bench_counters_set(suite, PERF_EVENT_IOC_RESET);
+    bench_counters_set(suite, PERF_EVENT_IOC_ENABLE);
+    if (bench) bench->run(bench->ctx, iterations);
+    bench_counters_set(suite, PERF_EVENT_IOC_DISABLE);
+    for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+        out[c] = suite->counter_fds[c] >= 0 ?
+                 bench_counter_read(suite->counter_fds[c]) : -1.0;
+    }
+#else
+    (void)suite;
+    if (bench) bench->run(bench->ctx, iterations);
+    for (int c = 0; c < BENCH_COUNTER_COUNT; c++) out[c] = -1.0;
+#endif
+    if (bench && bench->teardown) bench->teardown(bench->ctx, iterations);
+}
+
+static int bench_counters_available(const bench_suite_t* suite) {
+    for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+        if (suite->counter_fds[c] >= 0) return 1;
+    }
+    return 0;
+}
+
+// Open what the kernel and PMU allow; anything else stays at -1
+static void bench_counters_open(bench_suite_t* suite) {
+    for (int c = 0; c < BENCH_COUNTER_COUNT; c++) suite->counter_fds[c] = -1;
+#ifdef __linux__
+    {
+        static const struct { uint32_t type; uint64_t config; }
+            events[BENCH_COUNTER_COUNT] = {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HW_CACHE, BENCH_HW_CACHE(PERF_COUNT_HW_CACHE_L1D) },
+            { PERF_TYPE_HW_CACHE, BENCH_HW_CACHE(PERF_COUNT_HW_CACHE_LL) },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+        };
+        int first_errno = 0;
+        double samples[BENCH_COUNTER_COUNT][101];
+        double counts[BENCH_COUNTER_COUNT];
+
+        if (suite->options.no_counters) {
+            snprintf(suite->counter_status, sizeof(suite->counter_status),
+                     "off (--no-counters)");
+            return;
+        }
+        for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+            suite->counter_fds[c] = bench_perf_open(events[c].type,
+                                                    events[c].config);
+            if (suite->counter_fds[c] < 0 && !first_errno) first_errno = errno;
+        }
+        if (!bench_counters_available(suite)) {
+            snprintf(suite->counter_status, sizeof(suite->counter_status),
+                     "unavailable (perf_event_open: %s), timing only",
+                     strerror(first_errno));
+            return;
+        }
+
+        // What resetting, enabling and disabling costs by itself
+        for (int i = 0; i < 101; i++) {
+            bench_counted_batch(suite, NULL, 1, counts);
+            for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+                samples[c][i] = counts[c];
+            }
+        }
+        for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+            suite->counter_overhead[c] = bench_median(samples[c], 101);
+            if (suite->counter_overhead[c] < 0.0) {
+                suite->counter_overhead[c] = 0.0;
+            }
+        }
+    }
+#else
+    snprintf(suite->counter_status, sizeof(suite->counter_status),
+             "unavailable on this platform, timing only");
+#endif
+}
+
+static void bench_usage(const char* prog) {
+    fprintf(stderr,
+            "Usage: %s [--runs=N] [--samples=N] [--min-batch-ns=N] "
+            "[--warmup-ms=N]\n"
+            "          [--cpu=N | --no-pin] [--aslr] [--json=PATH] "
+            "[--filter=TEXT] [--quick]\n"
+            "          [--no-counters]\n", prog);
+}
+
+int bench_suite_init(bench_suite_t* suite, const char* name, int argc,
+                     char** argv) {
+    bench_options_t* o = &suite->options;
+
+    memset(suite, 0, sizeof(*suite));
+    suite->name = name;
+    o->runs = BENCH_DEFAULT_RUNS;
+    o->samples = BENCH_DEFAULT_SAMPLES;
+    o->min_batch_ns = BENCH_DEFAULT_MIN_BATCH_NS;
+    o->warmup_ns = BENCH_DEFAULT_WARMUP_NS;
+#ifdef __linux__
+    o->cpu = sched_getcpu();
+#else
+    o->cpu = -1;
+#endif
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (strncmp(a, "--runs=", 7) == 0) {
+            o->runs = atoi(a + 7);
+        } else if (strncmp(a, "--samples=", 10) == 0) {
+            o->samples = atoi(a + 10);
+        } else if (strncmp(a, "--min-batch-ns=", 15) == 0) {
+            o->min_batch_ns = strtoull(a + 15, NULL, 10);
+        } else if (strncmp(a, "--warmup-ms=", 12) == 0) {
+            o->warmup_ns = strtoull(a + 12, NULL, 10) * 1000000ULL;
+        } else if (strncmp(a, "--cpu=", 6) == 0) {
+            o->cpu = atoi(a + 6);
+        } else if (strcmp(a, "--no-pin") == 0) {
+            o->cpu = -1;
+        } else if (strcmp(a, "--aslr") == 0) {
+            o->keep_aslr = 1;
+        } else if (strcmp(a, "--no-counters") == 0) {
+            o->no_counters = 1;
+        } else if (strncmp(a, "--json=", 7) == 0) {
+            o->json_path = a + 7;
+        } else if (strncmp(a, "--filter=", 9) == 0) {
+            o->filter = a + 9;
+        } else if (strcmp(a, "--quick") == 0) {
+            o->runs = 3;
+            o->samples = 100;
+            o->warmup_ns = 5000000ULL;
+        } else {
+            bench_usage(argv[0]);
+            return -1;
+        }
+    }
+    if (o->runs < 1 || o->samples < 1) {
+        bench_usage(argv[0]);
+        return -1;
+    }
+
+    suite->aslr = bench_disable_aslr(argv, o->keep_aslr);
+    suite->pinned_cpu = bench_pin(o->cpu);
+    suite->clock_overhead_ns = bench_clock_overhead();
+    bench_counters_open(suite);
+    return 0;
+}
+
+void bench_suite_print_config(const bench_suite_t* suite) {
+    const bench_options_t* o = &suite->options;
+
+    printf("  Harness: %d runs x %d batches, >= %llu ns per batch, "
+           "warmup %llu ms\n", o->runs, o->samples,
+           (unsigned long long)o->min_batch_ns,
+           (unsigned long long)(o->warmup_ns / 1000000ULL));
+    if (suite->pinned_cpu >= 0) {
+        printf("  CPU: pinned to %d\n", suite->pinned_cpu);
+    } else {
+        printf("  CPU: not pinned\n");
+    }
+    printf("  ASLR: %s\n", suite->aslr ? "on" : "off");
+    printf("  Clock overhead: %.0f ns\n", suite->clock_overhead_ns);
+    if (bench_counters_available(suite)) {
+        printf("  Counters:");
+        for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+            if (suite->counter_fds[c] >= 0) {
+                printf(" %s", bench_counter_names[c]);
+            }
+        }
+        printf("\n");
+    } else {
+        printf("  Counters: %s\n", suite->counter_status);
+    }
+}
+
+void bench_suite_info(bench_suite_t* suite, const char* key, const char* value) {
+    if (suite->info_count >= BENCH_MAX_INFO) return;
+    suite->info_keys[suite->info_count] = key;
+    snprintf(suite->info_values[suite->info_count],
+             sizeof(suite->info_values[0]), "%s", value);
+    suite->info_count++;
+}
+
+// One timed batch, in ns per operation with the clock cost removed
+static double bench_batch(const bench_suite_t* suite,
+                          const bench_case_t* bench, uint64_t iterations) {
+    uint64_t start, elapsed;
+    double net;
+
+    if (bench->setup) bench->setup(bench->ctx, iterations);
+    start = bench_now_ns();
+    bench->run(bench->ctx, iterations);
+    elapsed = bench_now_ns() - start;
+    if (bench->teardown) bench->teardown(bench->ctx, iterations);
+
+    net = (double)elapsed - suite->clock_overhead_ns;
+    if (net < 0.0) net = 0.0;
+    return net / (double)iterations;
+}
+
+// Double the batch until it lasts min_batch_ns or hits the case's cap.
+// The fastest of a few tries is used so one cold batch cannot end the
+// search early.
+static uint64_t bench_calibrate(const bench_suite_t* suite,
+                                const bench_case_t* bench) {
+    uint64_t iterations = 1;
+    for (;;) {
+        double per_op = bench_batch(suite, bench, iterations);
+        for (int i = 0; i < 2; i++) {
+            double again = bench_batch(suite, bench, iterations);
+            if (again < per_op) per_op = again;
+        }
+        if (per_op * (double)iterations >= (double)suite->options.min_batch_ns ||
+            iterations >= (UINT64_C(1) << 30)) {
+            break;
+        }
+        if (bench->max_batch && iterations * 2 > bench->max_batch) {
+            iterations = bench->max_batch;
+            break;
+        }
+        iterations *= 2;
+    }
+    return iterations;
+}
+
+// Counter run, kept apart from the timed runs so the ioctls between
+// batches do not disturb the timing
+static void bench_count(const bench_suite_t* suite, const bench_case_t* bench,
+                        uint64_t iterations, bench_result_t* r) {
+    double totals[BENCH_COUNTER_COUNT] = {0};
+    double counts[BENCH_COUNTER_COUNT];
+    int valid[BENCH_COUNTER_COUNT];
+    int batches = suite->options.samples;
+
+    for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+        r->counters[c] = -1.0;
+        valid[c] = suite->counter_fds[c] >= 0;
+    }
+    if (!bench_counters_available(suite)) return;
+
+    for (int s = 0; s < batches; s++) {
+        bench_counted_batch(suite, bench, iterations, counts);
+        for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+            if (counts[c] < 0.0) valid[c] = 0;  // Never scheduled
+            totals[c] += counts[c] - suite->counter_overhead[c];
+        }
+    }
+    for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+        if (!valid[c]) continue;
+        // The overhead estimate can exceed a tiny count
+        r->counters[c] = totals[c] > 0.0 ?
+            totals[c] / ((double)batches * (double)iterations) : 0.0;
+    }
+}
+
+static void bench_print_counters(const bench_result_t* r) {
+    const double* k = r->counters;
+    int any = 0;
+
+    for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+        if (k[c] >= 0.0) any = 1;
+    }
+    if (!any) return;
+    printf("%-40s  per op:", "");
+    for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+        if (k[c] >= 0.0) printf(" %s=%.2f", bench_counter_names[c], k[c]);
+    }
+    if (k[BENCH_COUNTER_INSTRUCTIONS] >= 0.0 && k[BENCH_COUNTER_CYCLES] > 0.0) {
+        printf(" ipc=%.2f",
+               k[BENCH_COUNTER_INSTRUCTIONS] / k[BENCH_COUNTER_CYCLES]);
+    }
+    printf("\n");
+}
+
+const bench_result_t* bench_suite_run(bench_suite_t* suite,
+                                      const bench_case_t* bench) {
+    const bench_options_t* o = &suite->options;
+    size_t total = (size_t)o->runs * (size_t)o->samples;
+    double* samples;
+    double* run_medians;
+    double* scratch;
+    bench_result_t* r;
+    uint64_t iterations, warm_start;
+    double sum = 0.0;
+
+    if (o->filter && !strstr(bench->name, o->filter)) return NULL;
+    if (suite->count >= BENCH_MAX_RESULTS) return NULL;
+
+    samples = malloc(total * sizeof(double));
+    run_medians = malloc((size_t)o->runs * sizeof(double));
+    scratch = malloc((size_t)o->samples * sizeof(double));
+    if (!samples || !run_medians || !scratch) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+
+    iterations = bench_calibrate(suite, bench);
+    warm_start = bench_now_ns();
+    while (bench_now_ns() - warm_start < o->warmup_ns) {
+        bench_batch(suite, bench, iterations);
+    }
+
+    for (int run = 0; run < o->runs; run++) {
+        double* block = samples + (size_t)run * (size_t)o->samples;
+        for (int s = 0; s < o->samples; s++) {
+            block[s] = bench_batch(suite, bench, iterations);
+            sum += block[s];
+        }
+        memcpy(scratch, block, (size_t)o->samples * sizeof(double));
+        run_medians[run] = bench_median(scratch, (size_t)o->samples);
+    }
+
+    r = &suite->results[suite->count++];
+    memset(r, 0, sizeof(*r));
+    snprintf(r->name, sizeof(r->name), "%s", bench->name);
+    r->batch_iterations = iterations;
+    r->runs = o->runs;
+    r->samples = total;
+    r->median_ns = bench_median(run_medians, (size_t)o->runs);
+    for (int run = 0; run < o->runs; run++) {
+        double d = run_medians[run] - r->median_ns;
+        run_medians[run] = d < 0.0 ? -d : d;
+    }
+    r->mad_ns = bench_median(run_medians, (size_t)o->runs);
+
+    qsort(samples, total, sizeof(double), bench_compare_double);
+    r->mean_ns = sum / (double)total;
+    r->min_ns = samples[0];
+    r->max_ns = samples[total - 1];
+    r->p50_ns = bench_percentile(samples, total, 50.0);
+    r->p99_ns = bench_percentile(samples, total, 99.0);
+    r->p999_ns = bench_percentile(samples, total, 99.9);
+    bench_count(suite, bench, iterations, r);
+
+    // avg/min/max lead so visualize.py can still parse the line
+    printf("%-40s: avg=%6.0f ns, min=%6.0f ns, max=%6.0f ns | "
+           "median=%.1f +/- %.1f ns, p99=%.1f ns, p99.9=%.1f ns "
+           "(%llu ops/batch)\n",
+           r->name, r->mean_ns, r->min_ns, r->max_ns, r->median_ns,
+           r->mad_ns, r->p99_ns, r->p999_ns,
+           (unsigned long long)r->batch_iterations);
+    bench_print_counters(r);
+    fflush(stdout);
+
+    free(scratch);
+    free(run_medians);
+    free(samples);
+    return r;
+}
+
+static void bench_json_string(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') {
+            fputc('\\', f);
+            fputc(*s, f);
+        } else if ((unsigned char)*s < 0x20) {
+            fprintf(f, "\\u%04x", (unsigned)(unsigned char)*s);
+        } else {
+            fputc(*s, f);
+        }
+    }
+    fputc('"', f);
+}
+
+int bench_suite_finish(bench_suite_t* suite) {
+    const bench_options_t* o = &suite->options;
+    FILE* f;
+
+    if (!o->json_path) return 0;
+    f = fopen(o->json_path, "w");
+    if (!f) {
+        perror(o->json_path);
+        return -1;
+    }
+
+    fprintf(f, "{\n  \"suite\": ");
+    bench_json_string(f, suite->name);
+    fprintf(f, ",\n  \"harness\": {\"runs\": %d, \"samples\": %d, "
+               "\"min_batch_ns\": %llu, \"warmup_ns\": %llu, \"cpu\": %d, "
+               "\"aslr\": %d, \"clock_overhead_ns\": %.1f, \"counters\": [",
+            o->runs, o->samples, (unsigned long long)o->min_batch_ns,
+            (unsigned long long)o->warmup_ns, suite->pinned_cpu,
+            suite->aslr, suite->clock_overhead_ns);
+    for (int c = 0, n = 0; c < BENCH_COUNTER_COUNT; c++) {
+        if (suite->counter_fds[c] < 0) continue;
+        fprintf(f, "%s\"%s\"", n++ ? ", " : "", bench_counter_names[c]);
+    }
+    fprintf(f, "]},\n");
+    fprintf(f, "  \"config\": {");
+    for (size_t i = 0; i < suite->info_count; i++) {
+        fprintf(f, "%s", i ? ", " : "");
+        bench_json_string(f, suite->info_keys[i]);
+        fprintf(f, ": ");
+        bench_json_string(f, suite->info_values[i]);
+    }
+    fprintf(f, "},\n  \"results\": [\n");
+    for (size_t i = 0; i < suite->count; i++) {
+        const bench_result_t* r = &suite->results[i];
+        fprintf(f, "    {\"name\": ");
+        bench_json_string(f, r->name);
+        fprintf(f, ", \"batch_iterations\": %llu, \"runs\": %d, "
+                   "\"samples\": %zu, \"median_ns\": %.3f, \"mad_ns\": %.3f, "
+                   "\"mean_ns\": %.3f, \"min_ns\": %.3f, \"max_ns\": %.3f, "
+                   "\"p50_ns\": %.3f, \"p99_ns\": %.3f, \"p999_ns\": %.3f",
+                (unsigned long long)r->batch_iterations, r->runs, r->samples,
+                r->median_ns, r->mad_ns, r->mean_ns, r->min_ns, r->max_ns,
+                r->p50_ns, r->p99_ns, r->p999_ns);
+        if (bench_counters_available(suite)) {
+            fprintf(f, ", \"counters\": {");
+            for (int c = 0, n = 0; c < BENCH_COUNTER_COUNT; c++) {
+                if (r->counters[c] < 0.0) continue;
+                fprintf(f, "%s\"%s\": %.4f", n++ ? ", " : "",
+                        bench_counter_names[c], r->counters[c]);
+            }
+            fprintf(f, "}");
+        }
+        fprintf(f, "}%s\n", i + 1 < suite->count ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+
+    if (fclose(f) != 0) {
+        perror(o->json_path);
+        return -1;
+    }
+    printf("\nJSON results written to %s\n", o->json_path);
+    return 0;
+}
+
+#endif /* BENCH_HARNESS_IMPLEMENTATION */
+
+#endif /* BENCH_HARNESS_H */
@@ -0,0 +1,265 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L  /* For clock_gettime on macOS */
+#define _GNU_SOURCE               /* For CPU pinning on Linux */
+#endif
+
+#define BENCH_HARNESS_IMPLEMENTATION
+#include "bench_harness.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ss_lib.h"
+#include "baselines.h"
+
+// Library overhead against naive dispatch.
+//
+// The baselines in baselines.h and every ss_emit variant call the same 16
+// handlers, one per signal, round-robin over the signals. Each library case
+// is then reported as a ratio to the function pointer array (the floor: an
+// indexed indirect call) and to the name hash (the cheapest way to look a
+// handler up by name). The hash over the floor is what a name lookup costs
+// at all; the library over the hash is what its own lookup, locking,
+// instrumentation and emit path add, plus building the ss_data_t for the
+// typed helpers.
+//
+// The deferred and ISR queues are not compared here: their costs are
+// enqueue and drain, which benchmark_ss_lib reports per entry.
+
+#define NAMESPACE "baseline"
+#define MAX_CASES 16
+
+static char g_names[BASELINE_SIGNALS][32];       // "sig_NN"
+static char g_full_names[BASELINE_SIGNALS][32];  // "baseline::sig_NN"
+static int g_sink;
+
+static baseline_table_t g_table;
+static baseline_hash_t g_hash;
+static ss_data_t g_int_data;
+
+static void table_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        g_int_data.value.i_val = (int)i;
+        baseline_table_emit(&g_table, (unsigned)i, &g_int_data);
+    }
+}
+
+static void switch_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        g_int_data.value.i_val = (int)i;
+        baseline_switch_emit((unsigned)i, &g_int_data, &g_sink);
+    }
+}
+
+static void hash_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        g_int_data.value.i_val = (int)i;
+        baseline_hash_emit(&g_hash, g_full_names[i & (BASELINE_SIGNALS - 1)],
+                           &g_int_data);
+    }
+}
+
+static void emit_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        g_int_data.value.i_val = (int)i;
+        ss_emit(g_full_names[i & (BASELINE_SIGNALS - 1)], &g_int_data);
+    }
+}
+
+static void emit_void_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_emit_void(g_full_names[i & (BASELINE_SIGNALS - 1)]);
+    }
+}
+
+static void emit_int_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_emit_int(g_full_names[i & (BASELINE_SIGNALS - 1)], (int)i);
+    }
+}
+
+static void emit_float_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_emit_float(g_full_names[i & (BASELINE_SIGNALS - 1)], (float)i);
+    }
+}
+
+static void emit_double_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_emit_double(g_full_names[i & (BASELINE_SIGNALS - 1)], (double)i);
+    }
+}
+
+static void emit_string_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_emit_string(g_full_names[i & (BASELINE_SIGNALS - 1)], "payload");
+    }
+}
+
+static void emit_pointer_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_emit_pointer(g_full_names[i & (BASELINE_SIGNALS - 1)], &g_sink);
+    }
+}
+
+static void emit_namespaced_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        g_int_data.value.i_val = (int)i;
+        ss_emit_namespaced(NAMESPACE, g_names[i & (BASELINE_SIGNALS - 1)],
+                           &g_int_data);
+    }
+}
+
+// Results in run order; NULL where a case was filtered out
+static const bench_result_t* g_cases[MAX_CASES];
+static size_t g_case_count;
+
+static const bench_result_t* run_case(bench_suite_t* suite, const char* name,
+                                      void (*run)(void*, uint64_t)) {
+    bench_case_t bench = { name, NULL, run, NULL, NULL, 0 };
+    const bench_result_t* r = bench_suite_run(suite, &bench);
+    if (g_case_count < MAX_CASES) g_cases[g_case_count++] = r;
+    return r;
+}
+
+#if SS_ENABLE_THREAD_SAFETY || SS_ENABLE_PERFORMANCE_STATS
+// ss_emit_int with the runtime settings benchmark_ss_lib's emit path cases use
+static void run_emit_path(bench_suite_t* suite, const char* name,
+                          int thread_safe, int profiling) {
+#if SS_ENABLE_THREAD_SAFETY
+    ss_set_thread_safe(thread_safe);
+#else
+    (void)thread_safe;
+#endif
+#if SS_ENABLE_PERFORMANCE_STATS
+    ss_enable_profiling(profiling);
+#else
+    (void)profiling;
+#endif
+    run_case(suite, name, emit_int_run);
+#if SS_ENABLE_PERFORMANCE_STATS
+    ss_enable_profiling(0);
+#endif
+#if SS_ENABLE_THREAD_SAFETY
+    ss_set_thread_safe(0);
+#endif
+}
+#endif
+
+static void print_ratio(const bench_result_t* r, const bench_result_t* base) {
+    if (base && base->median_ns > 0) {
+        printf(" %9.2fx", r->median_ns / base->median_ns);
+    } else {
+        printf(" %10s", "-");
+    }
+}
+
+static void print_ratios(const bench_result_t* floor,
+                         const bench_result_t* hash) {
+    printf("\nRatios (median / baseline median):\n");
+    printf("----------------------------------\n");
+    printf("%-40s %10s %10s\n", "", "fn pointer", "name hash");
+    for (size_t i = 0; i < g_case_count; i++) {
+        const bench_result_t* r = g_cases[i];
+        if (!r) continue;
+        printf("%-40s", r->name);
+        print_ratio(r, floor);
+        print_ratio(r, hash);
+        printf("\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    static bench_suite_t suite;
+    const bench_result_t* floor;
+    const bench_result_t* hash;
+
+    if (bench_suite_init(&suite, "baseline", argc, argv) != 0) {
+        return 1;
+    }
+
+    printf("SS_Lib Baseline Comparison\n");
+    printf("==========================\n\n");
+
+    if (ss_init() != SS_OK) {
+        fprintf(stderr, "Failed to initialize SS_Lib\n");
+        return 1;
+    }
+
+    // The same 16 handlers behind every dispatch mechanism
+    for (int i = 0; i < BASELINE_SIGNALS; i++) {
+        snprintf(g_names[i], sizeof(g_names[i]), "sig_%02d", i);
+        snprintf(g_full_names[i], sizeof(g_full_names[i]), "%s::%s",
+                 NAMESPACE, g_names[i]);
+        g_table.handlers[i] = baseline_slots[i];
+        g_table.user_data[i] = &g_sink;
+        baseline_hash_connect(&g_hash, g_full_names[i], baseline_slots[i],
+                              &g_sink);
+        ss_signal_register(g_full_names[i]);
+        ss_connect(g_full_names[i], baseline_slots[i], &g_sink);
+    }
+    g_int_data.type = SS_TYPE_INT;
+
+    printf("Configuration:\n");
+    printf("  Signals: %d, 1 slot each, emitted round-robin\n",
+           BASELINE_SIGNALS);
+#if SS_USE_STATIC_MEMORY
+    printf("  Memory: Static\n");
+    bench_suite_info(&suite, "memory", "static");
+#else
+    printf("  Memory: Dynamic\n");
+    bench_suite_info(&suite, "memory", "dynamic");
+#endif
+#if SS_ENABLE_THREAD_SAFETY
+    printf("  Thread Safety: Enabled\n");
+    bench_suite_info(&suite, "thread_safety", "1");
+#else
+    printf("  Thread Safety: Disabled\n");
+    bench_suite_info(&suite, "thread_safety", "0");
+#endif
+    bench_suite_print_config(&suite);
+    printf("\n");
+
+    printf("Results (ns per operation):\n");
+    printf("---------------------------\n");
+
+    floor = run_case(&suite, "Baseline: function pointer array", table_run);
+    run_case(&suite, "Baseline: switch dispatch", switch_run);
+    hash = run_case(&suite, "Baseline: name hash dispatch", hash_run);
+
+    // Runtime locking is off by default; the locked case below shows what
+    // it adds
+    run_case(&suite, "ss_emit (prebuilt data)", emit_run);
+    run_case(&suite, "ss_emit_void", emit_void_run);
+    run_case(&suite, "ss_emit_int", emit_int_run);
+    run_case(&suite, "ss_emit_float", emit_float_run);
+    run_case(&suite, "ss_emit_double", emit_double_run);
+    run_case(&suite, "ss_emit_string", emit_string_run);
+    run_case(&suite, "ss_emit_pointer", emit_pointer_run);
+    run_case(&suite, "ss_emit_namespaced (prebuilt data)", emit_namespaced_run);
+#if SS_ENABLE_THREAD_SAFETY
+    run_emit_path(&suite, "ss_emit_int (locked)", 1, 0);
+#endif
+#if SS_ENABLE_PERFORMANCE_STATS
+    run_emit_path(&suite, "ss_emit_int (profiled)", 0, 1);
+#endif
+
+    print_ratios(floor, hash);
+
+    // Keep the handlers' work observable
+    if (g_sink == 42) printf("\n");
+
+    ss_cleanup();
+    return bench_suite_finish(&suite) == 0 ? 0 : 1;
+}
@@ -0,0 +1,275 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L  /* For clock_gettime and sigaction */
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <signal.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/time.h>
+#include "ss_lib.h"
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+// ISR-to-slot latency.
+//
+// Interrupt producers are simulated two ways: a SIGALRM handler driven by
+// a periodic setitimer, which preempts the consumer the way an interrupt
+// preempts a main loop, and a producer thread raising events on its own
+// schedule. Both call ss_emit_from_isr with a sequence number and stamp
+// the time in a side table. The consumer drains the queue with
+// ss_process_isr_queue, either continuously or once per main-loop tick.
+//
+// For every event the suite records:
+//   enqueue    cost of ss_emit_from_isr in the producer
+//   residency  enqueue until the drain that picked it up started
+//   dispatch   drain start until the slot ran (includes entries ahead of it)
+//   end-to-end enqueue until the slot ran
+// plus the share of events dropped because all SS_ISR_QUEUE_SIZE entries
+// were pending. Distributions use the library's log-linear histograms.
+//
+// Usage: benchmark_isr [events_per_sec] [duration_ms]
+
+#if SS_ENABLE_ISR_SAFE && SS_NEED_HISTOGRAM
+
+#define DEFAULT_RATE 20000
+#define DEFAULT_DURATION_MS 1000
+#define STAMP_RING 4096          // Power of two, far above SS_ISR_QUEUE_SIZE
+
+typedef enum {
+    PRODUCER_SIGNAL,
+    PRODUCER_THREAD
+} producer_t;
+
+typedef struct {
+    ss_histogram_t enqueue;
+    ss_histogram_t residency;
+    ss_histogram_t dispatch;
+    ss_histogram_t end_to_end;
+    uint64_t raised;
+    uint64_t dropped;
+    uint64_t delivered;
+    uint64_t stale;              // Stamp overwritten before delivery
+} isr_result_t;
+
+static isr_result_t g_result;
+
+// Written by the producer, read by the slot; a sequence check catches
+// entries whose stamp was reused
+static volatile uint64_t g_stamp_time[STAMP_RING];
+static volatile uint32_t g_stamp_seq[STAMP_RING];
+static volatile uint32_t g_next_seq;
+static volatile uint64_t g_drain_start;
+static atomic_int g_stop;
+
+static inline uint64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void sleep_until_ns(uint64_t deadline) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)(deadline / 1000000000ULL);
+    ts.tv_nsec = (long)(deadline % 1000000000ULL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {
+    }
+}
+
+// The simulated interrupt: everything here is async-signal-safe
+static void raise_event(void) {
+    uint32_t seq = g_next_seq++;
+    uint32_t idx = seq & (STAMP_RING - 1);
+    uint64_t start = get_time_ns();
+    uint64_t end;
+    ss_error_t err;
+
+    g_stamp_time[idx] = start;
+    g_stamp_seq[idx] = seq;
+    err = ss_emit_from_isr("isr_event", (int)seq);
+    end = get_time_ns();
+
+    ss_histogram_record(&g_result.enqueue, end - start);
+    g_result.raised++;
+    if (err == SS_ERR_WOULD_OVERFLOW) g_result.dropped++;
+}
+
+static void alarm_handler(int sig) {
+    (void)sig;
+    raise_event();
+}
+
+static void* producer_main(void* arg) {
+    uint64_t interval = *(const uint64_t*)arg;
+    uint64_t due = get_time_ns();
+
+    while (!atomic_load_explicit(&g_stop, memory_order_relaxed)) {
+        due += interval;
+        sleep_until_ns(due);
+        raise_event();
+    }
+    return NULL;
+}
+
+static void isr_slot(const ss_data_t* data, void* user_data) {
+    uint64_t now = get_time_ns();
+    uint32_t seq = (uint32_t)ss_data_get_int(data, 0);
+    uint32_t idx = seq & (STAMP_RING - 1);
+    uint64_t enqueued, picked_up;
+
+    (void)user_data;
+    if (g_stamp_seq[idx] != seq) {
+        g_result.stale++;
+        return;
+    }
+    enqueued = g_stamp_time[idx];
+    // An interrupt during the drain can add entries the same drain reaches
+    picked_up = enqueued > g_drain_start ? enqueued : g_drain_start;
+
+    ss_histogram_record(&g_result.residency, picked_up - enqueued);
+    ss_histogram_record(&g_result.dispatch, now - picked_up);
+    ss_histogram_record(&g_result.end_to_end, now - enqueued);
+    g_result.delivered++;
+}
+
+static void drain(void) {
+    g_drain_start = get_time_ns();
+    ss_process_isr_queue();
+}
+
+static void run_scenario(producer_t producer, uint64_t rate,
+                         uint64_t duration_ms, uint64_t tick_ns) {
+    uint64_t interval = 1000000000ULL / rate;
+    uint64_t end, next_tick;
+    pthread_t thread;
+    struct sigaction sa;
+    struct itimerval timer;
+
+    memset(&g_result, 0, sizeof(g_result));
+    ss_init();
+    ss_signal_register("isr_event");
+    ss_connect("isr_event", isr_slot, NULL);
+
+    atomic_store(&g_stop, 0);
+    if (producer == PRODUCER_SIGNAL) {
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = alarm_handler;
+        sa.sa_flags = SA_RESTART;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGALRM, &sa, NULL);
+
+        memset(&timer, 0, sizeof(timer));
+        timer.it_interval.tv_usec = (suseconds_t)(interval / 1000);
+        if (timer.it_interval.tv_usec == 0) timer.it_interval.tv_usec = 1;
+        timer.it_value = timer.it_interval;
+        setitimer(ITIMER_REAL, &timer, NULL);
+    } else {
+        pthread_create(&thread, NULL, producer_main, &interval);
+    }
+
+    // The main loop: drain continuously, or once per tick
+    end = get_time_ns() + duration_ms * 1000000ULL;
+    next_tick = get_time_ns();
+    while (get_time_ns() < end) {
+        if (tick_ns) {
+            next_tick += tick_ns;
+            sleep_until_ns(next_tick);
+        }
+        drain();
+    }
+
+    if (producer == PRODUCER_SIGNAL) {
+        memset(&timer, 0, sizeof(timer));
+        setitimer(ITIMER_REAL, &timer, NULL);
+        signal(SIGALRM, SIG_IGN);
+    } else {
+        atomic_store(&g_stop, 1);
+        pthread_join(thread, NULL);
+    }
+    drain();
+    ss_cleanup();
+}
+
+static void print_histogram(const char* label, const ss_histogram_t* h) {
+    printf("    %-11s p50=%8llu  p99=%8llu  p99.9=%8llu  max=%9llu ns\n",
+           label,
+           (unsigned long long)ss_histogram_percentile(h, 50.0),
+           (unsigned long long)ss_histogram_percentile(h, 99.0),
+           (unsigned long long)ss_histogram_percentile(h, 99.9),
+           (unsigned long long)h->max_value);
+}
+
+static void print_scenario(const char* producer, uint64_t tick_ns) {
+    const isr_result_t* r = &g_result;
+    char drain_label[48];
+
+    if (tick_ns) {
+        snprintf(drain_label, sizeof(drain_label), "drain every %llu us",
+                 (unsigned long long)(tick_ns / 1000));
+    } else {
+        snprintf(drain_label, sizeof(drain_label), "continuous drain");
+    }
+    printf("  %s, %s: %llu raised, %llu delivered, %.2f%% overflowed",
+           producer, drain_label, (unsigned long long)r->raised,
+           (unsigned long long)r->delivered,
+           r->raised ? 100.0 * (double)r->dropped / (double)r->raised : 0.0);
+    if (r->stale) printf(", %llu stale", (unsigned long long)r->stale);
+    printf("\n");
+    print_histogram("enqueue", &r->enqueue);
+    print_histogram("residency", &r->residency);
+    print_histogram("dispatch", &r->dispatch);
+    print_histogram("end-to-end", &r->end_to_end);
+}
+
+#endif /* SS_ENABLE_ISR_SAFE && SS_NEED_HISTOGRAM */
+
+int main(int argc, char** argv) {
+    printf("SS_Lib ISR Latency Benchmark\n");
+    printf("============================\n\n");
+
+#if !(SS_ENABLE_ISR_SAFE && SS_NEED_HISTOGRAM)
+    (void)argc;
+    (void)argv;
+    printf("Needs SS_ENABLE_ISR_SAFE and latency histograms "
+           "(SS_ENABLE_PERFORMANCE_STATS or SS_ENABLE_QUEUE_STATS); skipping\n");
+    return 0;
+#else
+    static const uint64_t ticks_us[] = { 0, 100, 1000 };
+    static const char* producers[] = { "timer signal", "producer thread" };
+    long rate = argc > 1 ? atol(argv[1]) : DEFAULT_RATE;
+    long duration_ms = argc > 2 ? atol(argv[2]) : DEFAULT_DURATION_MS;
+
+    if (rate < 1 || rate > 1000000 || duration_ms < 1) {
+        fprintf(stderr, "Usage: %s [events_per_sec] [duration_ms]\n", argv[0]);
+        return 1;
+    }
+
+#ifdef __linux__
+    // Default 50 us timer slack would show up as tick jitter
+    prctl(PR_SET_TIMERSLACK, 1UL);
+#endif
+
+    printf("Configuration:\n");
+    printf("  Event rate: %ld/s (interval %ld us)\n", rate, 1000000L / rate);
+    printf("  Duration: %ld ms per scenario\n", duration_ms);
+    printf("  ISR queue size: %d entries\n", SS_ISR_QUEUE_SIZE);
+    printf("  Thread safety: %s\n\n", SS_ENABLE_THREAD_SAFETY ? "on" : "off");
+
+    printf("Results:\n");
+    printf("--------\n");
+    for (int p = 0; p < 2; p++) {
+        for (size_t t = 0; t < sizeof(ticks_us) / sizeof(ticks_us[0]); t++) {
+            run_scenario((producer_t)p, (uint64_t)rate, (uint64_t)duration_ms,
+                         ticks_us[t] * 1000);
+            print_scenario(producers[p], ticks_us[t] * 1000);
+        }
+    }
+    return 0;
+#endif
+}
@@ -0,0 +1,285 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L  /* For clock_gettime and clock_nanosleep */
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include "ss_lib.h"
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+// Tail latency under load.
+//
+// One thread emits at a fixed target rate (open loop): operation i is due
+// at start + i * interval whether or not earlier ones finished on time.
+// Latency is measured from the due time, not from when the call was
+// actually made, so a stall that delays a run of emissions is charged to
+// every emission it delayed (coordinated-omission correction). The raw
+// call duration is recorded too, as service time.
+//
+// Each rate runs twice: idle, then while background threads connect and
+// disconnect slots on the emitted signal, register and unregister signals,
+// and fill and flush the deferred queue. Latencies go into the library's
+// log-linear histograms, so percentiles are bucket upper bounds (within
+// 1/2^SS_PERF_HISTOGRAM_SUB_BUCKET_BITS of the true value).
+//
+// Usage: benchmark_latency [rate_per_sec] [duration_ms]
+
+#if SS_ENABLE_THREAD_SAFETY && SS_NEED_HISTOGRAM
+
+#define DEFAULT_RATE 100000
+#define DEFAULT_DURATION_MS 2000
+#define SPIN_NS 200000           // Sleep until this close, then spin
+#define CHURN_MAX_SLOTS 8        // Extra slots the connect churner keeps
+#define BACKGROUND_YIELD_EVERY 64
+
+typedef enum {
+    BACKGROUND_CONNECT,
+    BACKGROUND_REGISTER,
+    BACKGROUND_DEFERRED,
+    BACKGROUND_COUNT
+} background_t;
+
+static const char* background_names[BACKGROUND_COUNT] = {
+    "connect/disconnect", "register/unregister", "deferred fill/flush"
+};
+
+typedef struct {
+    pthread_t thread;
+    background_t kind;
+    uint64_t ops;
+} background_worker_t;
+
+typedef struct {
+    ss_histogram_t corrected;    // Due time to completion
+    ss_histogram_t service;      // Call duration only
+    uint64_t background_ops[BACKGROUND_COUNT];
+    uint64_t ops;
+    uint64_t late;               // Emissions that started after their due time
+    uint64_t elapsed_ns;
+} latency_result_t;
+
+static atomic_int g_stop;
+static int g_slot_work;
+
+static inline uint64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void sleep_until_ns(uint64_t deadline) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)(deadline / 1000000000ULL);
+    ts.tv_nsec = (long)(deadline % 1000000000ULL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {
+    }
+}
+
+static void empty_slot(const ss_data_t* data, void* user_data) {
+    (void)data;
+    (void)user_data;
+}
+
+static void work_slot(const ss_data_t* data, void* user_data) {
+    (void)user_data;
+    g_slot_work += ss_data_get_int(data, 0);
+}
+
+static void* background_main(void* arg) {
+    background_worker_t* w = (background_worker_t*)arg;
+    ss_connection_t handles[CHURN_MAX_SLOTS] = {0};
+    char name[32];
+    uint64_t i = 0;
+
+    snprintf(name, sizeof(name), "lat_tmp_%d", (int)w->kind);
+    while (!atomic_load_explicit(&g_stop, memory_order_relaxed)) {
+        switch (w->kind) {
+        case BACKGROUND_CONNECT: {
+            // Replace the oldest extra slot, so the list emitters walk
+            // keeps changing length and order
+            ss_connection_t* h = &handles[i % CHURN_MAX_SLOTS];
+            if (*h) ss_disconnect_handle(*h);
+            *h = 0;
+            ss_connect_ex("lat_signal", empty_slot, NULL,
+                          (ss_priority_t)(i % 3 == 0 ? SS_PRIORITY_HIGH
+                                                     : SS_PRIORITY_NORMAL),
+                          h);
+            break;
+        }
+        case BACKGROUND_REGISTER:
+            ss_signal_register(name);
+            ss_signal_unregister(name);
+            break;
+        case BACKGROUND_DEFERRED:
+            // Fill to capacity, then flush under the library lock
+            if (ss_emit_deferred("lat_deferred", NULL) ==
+                SS_ERR_WOULD_OVERFLOW) {
+                ss_flush_deferred();
+            }
+            break;
+        default:
+            break;
+        }
+        i++;
+        if (i % BACKGROUND_YIELD_EVERY == 0) sched_yield();
+    }
+    for (int s = 0; s < CHURN_MAX_SLOTS; s++) {
+        if (handles[s]) ss_disconnect_handle(handles[s]);
+    }
+    w->ops = i;
+    return NULL;
+}
+
+static void setup(void) {
+    ss_init();
+    ss_set_thread_safe(1);
+    ss_signal_register("lat_signal");
+    ss_signal_register("lat_deferred");
+    ss_set_max_slots_per_signal(CHURN_MAX_SLOTS + 8);
+    // The real-time handlers: one high-priority, three normal
+    ss_connect_ex("lat_signal", work_slot, NULL, SS_PRIORITY_HIGH, NULL);
+    for (int i = 0; i < 3; i++) {
+        ss_connect("lat_signal", work_slot, NULL);
+    }
+    ss_connect("lat_deferred", empty_slot, NULL);
+}
+
+static void run_open_loop(latency_result_t* r, uint64_t rate,
+                          uint64_t duration_ms, int with_background) {
+    background_worker_t workers[BACKGROUND_COUNT];
+    uint64_t interval = 1000000000ULL / rate;
+    uint64_t count = rate * duration_ms / 1000;
+    uint64_t start, end, i;
+
+    memset(r, 0, sizeof(*r));
+    ss_histogram_reset(&r->corrected);
+    ss_histogram_reset(&r->service);
+
+    setup();
+    atomic_store(&g_stop, 0);
+    if (with_background) {
+        for (int b = 0; b < BACKGROUND_COUNT; b++) {
+            workers[b].kind = (background_t)b;
+            workers[b].ops = 0;
+            pthread_create(&workers[b].thread, NULL, background_main,
+                           &workers[b]);
+        }
+    }
+
+    start = get_time_ns() + 1000000;  // Let the background threads start
+    for (i = 0; i < count; i++) {
+        uint64_t due = start + i * interval;
+        uint64_t now = get_time_ns();
+        uint64_t begin, done;
+
+        if (now < due) {
+            if (due - now > SPIN_NS) sleep_until_ns(due - SPIN_NS);
+            while ((now = get_time_ns()) < due) {
+            }
+        } else if (now > due) {
+            r->late++;
+        }
+
+        begin = now;
+        ss_emit_int("lat_signal", (int)i);
+        done = get_time_ns();
+
+        ss_histogram_record(&r->corrected, done - due);
+        ss_histogram_record(&r->service, done - begin);
+    }
+    end = get_time_ns();
+
+    atomic_store(&g_stop, 1);
+    if (with_background) {
+        for (int b = 0; b < BACKGROUND_COUNT; b++) {
+            pthread_join(workers[b].thread, NULL);
+            r->background_ops[b] = workers[b].ops;
+        }
+    }
+    ss_cleanup();
+
+    r->ops = count;
+    r->elapsed_ns = end - start;
+}
+
+static void print_histogram(const char* label, const ss_histogram_t* h) {
+    printf("    %-10s p50=%8llu  p99=%8llu  p99.9=%8llu  max=%9llu ns\n",
+           label,
+           (unsigned long long)ss_histogram_percentile(h, 50.0),
+           (unsigned long long)ss_histogram_percentile(h, 99.0),
+           (unsigned long long)ss_histogram_percentile(h, 99.9),
+           (unsigned long long)h->max_value);
+}
+
+static void print_result(const char* phase, uint64_t rate,
+                         const latency_result_t* r) {
+    printf("  %s @ %llu/s: achieved %.0f/s, %.2f%% started late\n", phase,
+           (unsigned long long)rate,
+           (double)r->ops * 1e9 / (double)r->elapsed_ns,
+           100.0 * (double)r->late / (double)r->ops);
+    print_histogram("corrected", &r->corrected);
+    print_histogram("service", &r->service);
+    if (r->background_ops[0] == 0) return;
+    printf("    background:");
+    for (int b = 0; b < BACKGROUND_COUNT; b++) {
+        printf(" %s %llu%s", background_names[b],
+               (unsigned long long)r->background_ops[b],
+               b + 1 < BACKGROUND_COUNT ? "," : " ops\n");
+    }
+}
+
+#endif /* SS_ENABLE_THREAD_SAFETY && SS_NEED_HISTOGRAM */
+
+int main(int argc, char** argv) {
+    printf("SS_Lib Tail Latency Benchmark\n");
+    printf("=============================\n\n");
+
+#if !(SS_ENABLE_THREAD_SAFETY && SS_NEED_HISTOGRAM)
+    (void)argc;
+    (void)argv;
+    printf("Needs SS_ENABLE_THREAD_SAFETY and latency histograms "
+           "(SS_ENABLE_PERFORMANCE_STATS or SS_ENABLE_QUEUE_STATS); skipping\n");
+    return 0;
+#else
+    static latency_result_t result;
+    long rate = argc > 1 ? atol(argv[1]) : DEFAULT_RATE;
+    long duration_ms = argc > 2 ? atol(argv[2]) : DEFAULT_DURATION_MS;
+
+    if (rate < 1 || rate > 100000000 || duration_ms < 1) {
+        fprintf(stderr, "Usage: %s [rate_per_sec] [duration_ms]\n", argv[0]);
+        return 1;
+    }
+
+#ifdef __linux__
+    // Default 50 us timer slack would show up as scheduling latency
+    prctl(PR_SET_TIMERSLACK, 1UL);
+#endif
+
+    printf("Configuration:\n");
+    printf("  Target rate: %ld emissions/s (interval %llu ns)\n", rate,
+           (unsigned long long)(1000000000ULL / (uint64_t)rate));
+    printf("  Duration: %ld ms per phase\n", duration_ms);
+    printf("  Slots: 4 on the emitted signal, up to %d more from churn\n",
+           CHURN_MAX_SLOTS);
+    printf("  Background: %d threads (connect/disconnect, "
+           "register/unregister, deferred fill/flush)\n\n", BACKGROUND_COUNT);
+
+    printf("Results:\n");
+    printf("--------\n");
+    run_open_loop(&result, (uint64_t)rate, (uint64_t)duration_ms, 0);
+    print_result("idle", (uint64_t)rate, &result);
+    run_open_loop(&result, (uint64_t)rate, (uint64_t)duration_ms, 1);
+    print_result("under load", (uint64_t)rate, &result);
+
+    return 0;
+#endif
+}
@@ -0,0 +1,295 @@
+// Memory footprint benchmark.
+//
+// Builds the library into this translation unit with SS_MALLOC, SS_CALLOC,
+// SS_FREE and SS_STRDUP routed through a counting allocator, so it can
+// report the size of the internal structures alongside the heap bytes and
+// allocation counts of each operation. Heap figures are requested bytes;
+// allocator headers and rounding are not included.
+//
+// Text, data and bss sizes of the library object come from the build
+// (run_footprint.sh passes them in from size(1)), since this binary only
+// sees itself.
+//
+// Usage: benchmark_memory [--config=NAME] [--text=N --data=N --bss=N]
+//                         [--json=PATH]
+
+#include <stddef.h>
+
+static void* fp_malloc(size_t size);
+static void* fp_calloc(size_t count, size_t size);
+static void fp_free(void* ptr);
+static char* fp_strdup(const char* str);
+
+#define SS_MALLOC(size) fp_malloc(size)
+#define SS_CALLOC(count, size) fp_calloc((count), (size))
+#define SS_FREE(ptr) fp_free(ptr)
+#define SS_STRDUP(str) fp_strdup(str)
+
+#include "../src/ss_lib.c"
+
+#define OPS 64                   // Operations averaged per figure
+#define MAX_RESULTS 64
+
+// Static pools must hold every signal and slot the run creates
+#if SS_USE_STATIC_MEMORY
+#define SIGNAL_OPS (SS_MAX_SIGNALS / 2 < OPS ? SS_MAX_SIGNALS / 2 : OPS)
+#else
+#define SIGNAL_OPS OPS
+#endif
+
+// Counting allocator: a size header in front of every block
+typedef union {
+    size_t size;
+    max_align_t align;
+} fp_header_t;
+
+typedef struct {
+    long long live;              // Requested bytes currently allocated
+    long long peak;
+    long long allocs;
+    long long frees;
+} heap_counters_t;
+
+static heap_counters_t g_heap;
+
+static void* fp_account(fp_header_t* h, size_t size) {
+    if (!h) return NULL;
+    h->size = size;
+    g_heap.live += (long long)size;
+    g_heap.allocs++;
+    if (g_heap.live > g_heap.peak) g_heap.peak = g_heap.live;
+    return h + 1;
+}
+
+static void* fp_malloc(size_t size) {
+    return fp_account(malloc(sizeof(fp_header_t) + size), size);
+}
+
+static void* fp_calloc(size_t count, size_t size) {
+    if (size && count > ((size_t)-1 - sizeof(fp_header_t)) / size) return NULL;
+    return fp_account(calloc(1, sizeof(fp_header_t) + count * size),
+                      count * size);
+}
+
+static void fp_free(void* ptr) {
+    fp_header_t* h;
+    if (!ptr) return;
+    h = (fp_header_t*)ptr - 1;
+    g_heap.live -= (long long)h->size;
+    g_heap.frees++;
+    free(h);
+}
+
+static char* fp_strdup(const char* str) {
+    size_t len = strlen(str) + 1;
+    char* copy = fp_malloc(len);
+    if (copy) memcpy(copy, str, len);
+    return copy;
+}
+
+// Results, printed as a table and optionally written as JSON
+typedef struct {
+    char name[64];
+    double value;
+    const char* unit;
+} fp_result_t;
+
+static fp_result_t g_results[MAX_RESULTS];
+static size_t g_result_count;
+
+static void add_result(const char* name, double value, const char* unit) {
+    fp_result_t* r;
+    if (g_result_count >= MAX_RESULTS) return;
+    r = &g_results[g_result_count++];
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    r->value = value;
+    r->unit = unit;
+    printf("%-44s: %10.1f %s\n", r->name, r->value, r->unit);
+}
+
+// Heap change across `ops` calls of one operation
+static void add_op_result(const char* op, const heap_counters_t* before,
+                          int ops) {
+    char name[64];
+
+    snprintf(name, sizeof(name), "%s heap", op);
+    add_result(name, (double)(g_heap.live - before->live) / ops, "bytes/op");
+    snprintf(name, sizeof(name), "%s allocations", op);
+    add_result(name, (double)(g_heap.allocs - before->allocs) / ops,
+               "allocs/op");
+    snprintf(name, sizeof(name), "%s frees", op);
+    add_result(name, (double)(g_heap.frees - before->frees) / ops, "frees/op");
+}
+
+static void empty_slot(const ss_data_t* data, void* user_data) {
+    (void)data;
+    (void)user_data;
+}
+
+// Names typical of an application: "subsystem::event_NN"
+static void make_name(char* out, size_t size, int index) {
+    snprintf(out, size, "ui::button_clicked_%02d", index);
+    if (strlen(out) >= SS_MAX_SIGNAL_NAME_LENGTH) {
+        snprintf(out, size, "s%d", index);
+    }
+}
+
+static void measure_operations(void) {
+    char names[OPS][32];
+    ss_connection_t handles[OPS];
+    heap_counters_t before;
+    int i;
+
+    for (i = 0; i < SIGNAL_OPS; i++) {
+        make_name(names[i], sizeof(names[i]), i);
+    }
+
+    before = g_heap;
+    if (ss_init() != SS_OK) {
+        fprintf(stderr, "Failed to initialize SS_Lib\n");
+        exit(1);
+    }
+    add_op_result("init", &before, 1);
+
+    before = g_heap;
+    for (i = 0; i < SIGNAL_OPS; i++) ss_signal_register(names[i]);
+    add_op_result("signal register", &before, SIGNAL_OPS);
+
+    before = g_heap;
+    for (i = 0; i < SIGNAL_OPS; i++) {
+        ss_connect_ex(names[i], empty_slot, NULL, SS_PRIORITY_NORMAL,
+                      &handles[i]);
+    }
+    add_op_result("connect", &before, SIGNAL_OPS);
+
+    before = g_heap;
+    for (i = 0; i < OPS; i++) ss_emit_void(names[i % SIGNAL_OPS]);
+    add_op_result("emit void", &before, OPS);
+
+    before = g_heap;
+    for (i = 0; i < OPS; i++) ss_emit_string(names[i % SIGNAL_OPS], "payload");
+    add_op_result("emit string", &before, OPS);
+
+    // Enqueue and flush together, so the figure is net per deferred entry
+    before = g_heap;
+    for (i = 0; i < OPS; i++) {
+        ss_data_t* d = ss_data_create(SS_TYPE_STRING);
+        ss_data_set_string(d, "payload");
+        ss_emit_deferred(names[i % SIGNAL_OPS], d);
+        ss_data_destroy(d);
+        if ((i + 1) % SS_DEFERRED_QUEUE_SIZE == 0) ss_flush_deferred();
+    }
+    ss_flush_deferred();
+    add_op_result("deferred string emit + flush", &before, OPS);
+
+    before = g_heap;
+    for (i = 0; i < OPS; i++) {
+        ss_data_t* d = ss_data_create(SS_TYPE_STRING);
+        ss_data_set_string(d, "payload");
+        ss_data_destroy(d);
+    }
+    add_op_result("string data create/destroy", &before, OPS);
+
+    before = g_heap;
+    {
+        ss_batch_t* batch = ss_batch_create();
+        if (batch) {
+            add_result("batch heap", (double)(g_heap.live - before.live),
+                       "bytes");
+            ss_batch_destroy(batch);
+        }
+    }
+
+    before = g_heap;
+    for (i = 0; i < SIGNAL_OPS; i++) ss_disconnect_handle(handles[i]);
+    add_op_result("disconnect", &before, SIGNAL_OPS);
+
+    before = g_heap;
+    for (i = 0; i < SIGNAL_OPS; i++) ss_signal_unregister(names[i]);
+    add_op_result("signal unregister", &before, SIGNAL_OPS);
+
+    add_result("peak heap", (double)g_heap.peak, "bytes");
+
+    ss_cleanup();
+    add_result("heap after cleanup", (double)g_heap.live, "bytes");
+}
+
+static int write_json(const char* path, const char* config) {
+    FILE* f = fopen(path, "w");
+    size_t i;
+
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    fprintf(f, "{\n  \"suite\": \"memory footprint\",\n");
+    fprintf(f, "  \"config\": {\"name\": \"%s\", \"static_memory\": %d, "
+               "\"thread_safety\": %d, \"max_signal_name_length\": %d, "
+               "\"deferred_queue_size\": %d},\n",
+            config, SS_USE_STATIC_MEMORY, SS_ENABLE_THREAD_SAFETY,
+            SS_MAX_SIGNAL_NAME_LENGTH, SS_DEFERRED_QUEUE_SIZE);
+    fprintf(f, "  \"results\": [\n");
+    for (i = 0; i < g_result_count; i++) {
+        fprintf(f, "    {\"name\": \"%s\", \"value\": %.3f, \"unit\": \"%s\"}%s\n",
+                g_results[i].name, g_results[i].value, g_results[i].unit,
+                i + 1 < g_result_count ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    if (fclose(f) != 0) {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    const char* config = "default";
+    const char* json_path = NULL;
+    const char* sections[3] = { NULL, NULL, NULL };
+    static const char* section_names[3] = { "text", "data", "bss" };
+    int i, s;
+
+    for (i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--config=", 9) == 0) {
+            config = argv[i] + 9;
+        } else if (strncmp(argv[i], "--json=", 7) == 0) {
+            json_path = argv[i] + 7;
+        } else if (strncmp(argv[i], "--text=", 7) == 0) {
+            sections[0] = argv[i] + 7;
+        } else if (strncmp(argv[i], "--data=", 7) == 0) {
+            sections[1] = argv[i] + 7;
+        } else if (strncmp(argv[i], "--bss=", 6) == 0) {
+            sections[2] = argv[i] + 6;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    printf("SS_Lib Memory Footprint: %s\n", config);
+    printf("=========================\n\n");
+    printf("Configuration:\n");
+    printf("  Static memory: %s\n", SS_USE_STATIC_MEMORY ? "yes" : "no");
+    printf("  Thread safety: %s\n", SS_ENABLE_THREAD_SAFETY ? "yes" : "no");
+    printf("  Max signal name length: %d\n\n", SS_MAX_SIGNAL_NAME_LENGTH);
+
+    printf("Results:\n");
+    printf("--------\n");
+    for (s = 0; s < 3; s++) {
+        char name[64];
+        if (!sections[s]) continue;
+        snprintf(name, sizeof(name), "library %s", section_names[s]);
+        add_result(name, strtod(sections[s], NULL), "bytes");
+    }
+    add_result("sizeof(ss_context_t)", (double)sizeof(ss_context_t), "bytes");
+    add_result("sizeof(ss_signal_t)", (double)sizeof(ss_signal_t), "bytes");
+    add_result("sizeof(ss_slot_t)", (double)sizeof(ss_slot_t), "bytes");
+    add_result("sizeof(ss_deferred_entry_t)",
+               (double)sizeof(ss_deferred_entry_t), "bytes");
+    add_result("sizeof(ss_data_t)", (double)sizeof(ss_data_t), "bytes");
+
+    measure_operations();
+
+    if (json_path && write_json(json_path, config) != 0) return 1;
+    return 0;
+}
@@ -0,0 +1,314 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L  /* For clock_gettime and strdup */
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include "ss_lib.h"
+
+// Multithreaded contention benchmarks.
+//
+// Every scenario runs at 1, 2, 4, ... up to the maximum thread count with a
+// fixed number of operations per thread (weak scaling). Throughput is total
+// operations over wall time; latency is sampled on one operation in
+// LATENCY_SAMPLE_EVERY so the clock reads do not dominate the loop.
+//
+// Usage: benchmark_mt [max_threads] [ops_per_thread]
+
+#if SS_ENABLE_THREAD_SAFETY
+
+#define DEFAULT_MAX_THREADS 64
+#define DEFAULT_OPS_PER_THREAD 20000
+#define LATENCY_SAMPLE_EVERY 8
+#define CHURN_REGISTER_EVERY 256
+
+typedef enum {
+    SCENARIO_SAME_SIGNAL,
+    SCENARIO_DISJOINT_SIGNALS,
+    SCENARIO_CHURN,
+    SCENARIO_DEFERRED,
+    SCENARIO_COUNT
+} scenario_t;
+
+static const char* scenario_names[SCENARIO_COUNT] = {
+    "same-signal emit",
+    "disjoint-signal emit",
+    "emit/connect/disconnect churn",
+    "deferred enqueue (1 flusher)"
+};
+
+typedef struct {
+    pthread_t thread;
+    int index;
+    char own_signal[32];
+    scenario_t scenario;
+    int ops;
+    uint32_t* samples;
+    int sample_count;
+    uint64_t failed;           // Ops that errored, plus deferred queue-full retries
+} worker_t;
+
+static atomic_int g_ready;
+static atomic_int g_go;
+static atomic_int g_producers_done;
+
+static inline uint64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void empty_slot(const ss_data_t* data, void* user_data) {
+    (void)data;
+    (void)user_data;
+}
+
+static int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t percentile(const uint32_t* sorted, size_t n, double p) {
+    size_t idx;
+    if (n == 0) return 0;
+    idx = (size_t)(p / 100.0 * (double)(n - 1) + 0.5);
+    return sorted[idx];
+}
+
+// One operation of the scenario; returns non-zero on a library error
+static int run_op(worker_t* w, int i, ss_connection_t* handle) {
+    char name[32];
+
+    switch (w->scenario) {
+    case SCENARIO_SAME_SIGNAL:
+        return ss_emit_int("mt_shared", i) != SS_OK;
+    case SCENARIO_DISJOINT_SIGNALS:
+        return ss_emit_int(w->own_signal, i) != SS_OK;
+    case SCENARIO_CHURN:
+        // Half emits; the rest connect and disconnect on the shared signal
+        // so emitters walk a slot list that keeps changing. Every few
+        // hundred ops a short-lived signal is registered and removed.
+        if (i % CHURN_REGISTER_EVERY == CHURN_REGISTER_EVERY - 1) {
+            snprintf(name, sizeof(name), "mt_tmp_%d", w->index);
+            if (ss_signal_register(name) != SS_OK) return 1;
+            return ss_signal_unregister(name) != SS_OK;
+        }
+        switch (i % 4) {
+        case 0:
+            return ss_connect_ex("mt_churn", empty_slot, NULL,
+                                 SS_PRIORITY_NORMAL, handle) != SS_OK;
+        case 2:
+            return ss_disconnect_handle(*handle) != SS_OK;
+        default:
+            return ss_emit_int("mt_churn", i) != SS_OK;
+        }
+    case SCENARIO_DEFERRED: {
+        // A full queue is backpressure, not a lost op: yield so the
+        // flusher can drain, retry, and count the retry
+        ss_error_t err;
+        while ((err = ss_emit_deferred("mt_deferred", NULL)) ==
+               SS_ERR_WOULD_OVERFLOW) {
+            w->failed++;
+            sched_yield();
+        }
+        return err != SS_OK;
+    }
+    default:
+        return 1;
+    }
+}
+
+static void* worker_main(void* arg) {
+    worker_t* w = (worker_t*)arg;
+    ss_connection_t handle = 0;
+
+    atomic_fetch_add(&g_ready, 1);
+    while (!atomic_load(&g_go)) {
+        sched_yield();
+    }
+
+    for (int i = 0; i < w->ops; i++) {
+        if (i % LATENCY_SAMPLE_EVERY == 0) {
+            uint64_t start = get_time_ns();
+            w->failed += run_op(w, i, &handle);
+            uint64_t elapsed = get_time_ns() - start;
+            w->samples[w->sample_count++] =
+                elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed;
+        } else {
+            w->failed += run_op(w, i, &handle);
+        }
+    }
+    return NULL;
+}
+
+// Drains the deferred queue while producers run
+static void* flusher_main(void* arg) {
+    (void)arg;
+    while (!atomic_load(&g_producers_done)) {
+        ss_flush_deferred();
+        sched_yield();
+    }
+    ss_flush_deferred();
+    return NULL;
+}
+
+static void setup_scenario(scenario_t scenario, int threads) {
+    char name[32];
+
+    ss_init();
+    ss_set_thread_safe(1);
+
+    switch (scenario) {
+    case SCENARIO_SAME_SIGNAL:
+        ss_signal_register("mt_shared");
+        ss_connect("mt_shared", empty_slot, NULL);
+        break;
+    case SCENARIO_DISJOINT_SIGNALS:
+        for (int t = 0; t < threads; t++) {
+            snprintf(name, sizeof(name), "mt_own_%d", t);
+            ss_signal_register(name);
+            ss_connect(name, empty_slot, NULL);
+        }
+        break;
+    case SCENARIO_CHURN:
+        ss_signal_register("mt_churn");
+        ss_set_max_slots_per_signal((size_t)threads + 1);
+        break;
+    case SCENARIO_DEFERRED:
+        ss_signal_register("mt_deferred");
+        ss_connect("mt_deferred", empty_slot, NULL);
+        break;
+    default:
+        break;
+    }
+}
+
+typedef struct {
+    double mops;
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t p999;
+    double failed_pct;
+} scenario_result_t;
+
+static scenario_result_t run_scenario(scenario_t scenario, int threads, int ops) {
+    worker_t* workers = calloc((size_t)threads, sizeof(worker_t));
+    size_t per_thread = (size_t)ops / LATENCY_SAMPLE_EVERY + 1;
+    uint32_t* samples = malloc((size_t)threads * per_thread * sizeof(uint32_t));
+    pthread_t flusher;
+    scenario_result_t result = {0};
+    uint64_t failed = 0;
+    size_t total_samples = 0;
+
+    if (!workers || !samples) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+
+    setup_scenario(scenario, threads);
+    atomic_store(&g_ready, 0);
+    atomic_store(&g_go, 0);
+    atomic_store(&g_producers_done, 0);
+
+    for (int t = 0; t < threads; t++) {
+        workers[t].index = t;
+        snprintf(workers[t].own_signal, sizeof(workers[t].own_signal),
+                 "mt_own_%d", t);
+        workers[t].scenario = scenario;
+        workers[t].ops = ops;
+        workers[t].samples = samples + (size_t)t * per_thread;
+        pthread_create(&workers[t].thread, NULL, worker_main, &workers[t]);
+    }
+    if (scenario == SCENARIO_DEFERRED) {
+        pthread_create(&flusher, NULL, flusher_main, NULL);
+    }
+    while (atomic_load(&g_ready) < threads) {
+        sched_yield();
+    }
+
+    uint64_t start = get_time_ns();
+    atomic_store(&g_go, 1);
+    for (int t = 0; t < threads; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+    uint64_t elapsed = get_time_ns() - start;
+
+    atomic_store(&g_producers_done, 1);
+    if (scenario == SCENARIO_DEFERRED) {
+        pthread_join(flusher, NULL);
+    }
+
+    // Compact the per-thread sample runs, then sort once
+    for (int t = 0; t < threads; t++) {
+        memmove(samples + total_samples, workers[t].samples,
+                (size_t)workers[t].sample_count * sizeof(uint32_t));
+        total_samples += (size_t)workers[t].sample_count;
+        failed += workers[t].failed;
+    }
+    qsort(samples, total_samples, sizeof(uint32_t), compare_u32);
+
+    result.mops = (double)threads * ops / ((double)elapsed / 1e3);
+    result.p50 = percentile(samples, total_samples, 50.0);
+    result.p99 = percentile(samples, total_samples, 99.0);
+    result.p999 = percentile(samples, total_samples, 99.9);
+    result.failed_pct = 100.0 * (double)failed / ((double)threads * ops);
+
+    ss_cleanup();
+    free(samples);
+    free(workers);
+    return result;
+}
+
+#endif /* SS_ENABLE_THREAD_SAFETY */
+
+int main(int argc, char** argv) {
+    printf("SS_Lib Multithreaded Benchmark Suite\n");
+    printf("====================================\n\n");
+
+#if !SS_ENABLE_THREAD_SAFETY
+    (void)argc;
+    (void)argv;
+    printf("Thread safety is compiled out (SS_ENABLE_THREAD_SAFETY=0); skipping\n");
+    return 0;
+#else
+    int max_threads = argc > 1 ? atoi(argv[1]) : DEFAULT_MAX_THREADS;
+    int ops = argc > 2 ? atoi(argv[2]) : DEFAULT_OPS_PER_THREAD;
+
+    if (max_threads < 1 || ops < 1) {
+        fprintf(stderr, "Usage: %s [max_threads] [ops_per_thread]\n", argv[0]);
+        return 1;
+    }
+
+    printf("Configuration:\n");
+    printf("  Max threads: %d\n", max_threads);
+    printf("  Ops per thread: %d (latency sampled 1 in %d)\n\n", ops,
+           LATENCY_SAMPLE_EVERY);
+
+    for (int s = 0; s < SCENARIO_COUNT; s++) {
+        double base = 0.0;
+
+        printf("%s\n", scenario_names[s]);
+        printf("  %7s %10s %9s %9s %9s %11s %10s\n", "threads", "Mops/s",
+               "p50 ns", "p99 ns", "p99.9 ns", "efficiency", "retry/err");
+        for (int threads = 1; threads <= max_threads; threads *= 2) {
+            scenario_result_t r = run_scenario((scenario_t)s, threads, ops);
+            if (threads == 1) base = r.mops;
+            // Share of ideal linear scaling from the single-thread rate
+            printf("  %7d %10.2f %9u %9u %9u %10.1f%% %9.2f%%\n", threads,
+                   r.mops, r.p50, r.p99, r.p999,
+                   base > 0.0 ? 100.0 * r.mops / (base * threads) : 0.0,
+                   r.failed_pct);
+        }
+        printf("\n");
+    }
+
+    return 0;
+#endif
+}
@@ -0,0 +1,290 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L  /* For clock_gettime */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ss_lib.h"
+
+// Registry-size scaling benchmarks.
+//
+// The registry is grown through 10, 100, 1k, 10k and 100k signals. Names
+// follow a "subsystem::component::event" layout, so neighbouring entries
+// share long prefixes and every comparison has to walk past them. At each
+// size the suite times hit and miss lookups, emission, connection and
+// registration against signals picked uniformly across the registry.
+//
+// Results use the same "name: avg=, min=, max=" lines as
+// benchmark_ss_lib, so visualize.py can chart them against registry size.
+//
+// Usage: benchmark_scaling [max_signals]
+
+#define DEFAULT_MAX_SIGNALS 100000
+#define SAMPLE_COUNT 1024        // Distinct signals probed at each size
+#define BATCH 16                 // Ops per clock read
+#define OPS_BUDGET 6400000       // Ops x registry size per measurement
+#define MIN_OPS 64
+#define MAX_OPS 65536
+#define NAME_LENGTH 64
+
+static const char* subsystems[] = {
+    "audio", "input", "network", "physics", "renderer", "scripting",
+    "storage", "ui"
+};
+static const char* components[] = {
+    "animation_controller", "asset_cache", "collision_world", "connection_pool",
+    "event_router", "frame_scheduler", "gamepad_manager", "layout_engine",
+    "mixer_channel", "particle_system", "save_manager", "shader_library",
+    "socket_listener", "texture_streamer", "voice_allocator", "widget_tree"
+};
+static const char* events[] = {
+    "state_changed", "request_completed", "buffer_ready", "limit_exceeded"
+};
+
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+typedef struct {
+    const char* op;
+    size_t registry_size;
+    uint64_t total_time;
+    uint64_t min_time;
+    uint64_t max_time;
+    int iterations;
+} scaling_result_t;
+
+static char* g_names;            // NAME_LENGTH bytes per signal
+static size_t g_samples[SAMPLE_COUNT];
+static uint32_t g_rng = 12345;
+
+static inline uint64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint32_t next_random(void) {
+    g_rng = g_rng * 1103515245u + 12345u;
+    return g_rng >> 8;
+}
+
+static void empty_slot(const ss_data_t* data, void* user_data) {
+    (void)data;
+    (void)user_data;
+}
+
+// The unique part goes last, the way real event names differ
+static void make_name(char* out, size_t index, const char* suffix) {
+    int len = snprintf(out, NAME_LENGTH, "%s::%s::%s_%06zu%s",
+                       subsystems[index % COUNT_OF(subsystems)],
+                       components[(index / COUNT_OF(subsystems)) %
+                                  COUNT_OF(components)],
+                       events[(index / (COUNT_OF(subsystems) *
+                                        COUNT_OF(components))) %
+                              COUNT_OF(events)],
+                       index, suffix);
+    // Static builds keep short names; fall back rather than truncate
+    if (len < 0 || len >= SS_MAX_SIGNAL_NAME_LENGTH) {
+        snprintf(out, NAME_LENGTH, "s%zu::c%zu::e%zu%s",
+                 index % COUNT_OF(subsystems),
+                 (index / COUNT_OF(subsystems)) % COUNT_OF(components),
+                 index, suffix);
+    }
+}
+
+static const char* name_at(size_t index) {
+    return g_names + index * NAME_LENGTH;
+}
+
+static int ops_for_size(size_t size) {
+    size_t ops = OPS_BUDGET / size;
+    if (ops < MIN_OPS) ops = MIN_OPS;
+    if (ops > MAX_OPS) ops = MAX_OPS;
+    return (int)(ops / BATCH * BATCH);
+}
+
+static void begin_result(scaling_result_t* r, const char* op, size_t size) {
+    r->op = op;
+    r->registry_size = size;
+    r->total_time = 0;
+    r->min_time = UINT64_MAX;
+    r->max_time = 0;
+    r->iterations = 0;
+}
+
+static void record_batch(scaling_result_t* r, uint64_t elapsed, int ops) {
+    uint64_t per_op = elapsed / (uint64_t)ops;
+    r->total_time += elapsed;
+    r->iterations += ops;
+    if (per_op < r->min_time) r->min_time = per_op;
+    if (per_op > r->max_time) r->max_time = per_op;
+}
+
+static void print_result(const scaling_result_t* r) {
+    char label[64];
+    snprintf(label, sizeof(label), "Registry %s (n=%zu)", r->op,
+             r->registry_size);
+    printf("%-40s: avg=%6llu ns, min=%6llu ns, max=%6llu ns\n", label,
+           (unsigned long long)(r->total_time / (uint64_t)r->iterations),
+           (unsigned long long)r->min_time,
+           (unsigned long long)r->max_time);
+}
+
+// Grow the registry to `size`; each new signal gets one slot so emits
+// dispatch. Registration prepends, so the connect lookup hits at once.
+static int grow_registry(size_t from, size_t size) {
+    for (size_t i = from; i < size; i++) {
+        if (ss_signal_register(name_at(i)) != SS_OK ||
+            ss_connect(name_at(i), empty_slot, NULL) != SS_OK) {
+            fprintf(stderr, "Failed to register signal %zu\n", i);
+            return 0;
+        }
+    }
+    for (int i = 0; i < SAMPLE_COUNT; i++) {
+        g_samples[i] = next_random() % size;
+    }
+    return 1;
+}
+
+static void bench_lookup_hit(scaling_result_t* r, size_t size) {
+    int ops = ops_for_size(size);
+    begin_result(r, "lookup hit", size);
+    for (int i = 0; i < ops; i += BATCH) {
+        uint64_t start = get_time_ns();
+        for (int j = 0; j < BATCH; j++) {
+            ss_signal_exists(name_at(g_samples[(i + j) % SAMPLE_COUNT]));
+        }
+        record_batch(r, get_time_ns() - start, BATCH);
+    }
+}
+
+static void bench_lookup_miss(scaling_result_t* r, size_t size) {
+    char missing[BATCH][NAME_LENGTH];
+    int ops = ops_for_size(size);
+
+    // Same prefixes as real entries, so each compare runs long
+    for (int j = 0; j < BATCH; j++) {
+        make_name(missing[j], g_samples[j], "_missing");
+    }
+    begin_result(r, "lookup miss", size);
+    for (int i = 0; i < ops; i += BATCH) {
+        uint64_t start = get_time_ns();
+        for (int j = 0; j < BATCH; j++) {
+            ss_signal_exists(missing[j]);
+        }
+        record_batch(r, get_time_ns() - start, BATCH);
+    }
+}
+
+static void bench_emit(scaling_result_t* r, size_t size) {
+    int ops = ops_for_size(size);
+    begin_result(r, "emit", size);
+    for (int i = 0; i < ops; i += BATCH) {
+        uint64_t start = get_time_ns();
+        for (int j = 0; j < BATCH; j++) {
+            ss_emit_void(name_at(g_samples[(i + j) % SAMPLE_COUNT]));
+        }
+        record_batch(r, get_time_ns() - start, BATCH);
+    }
+}
+
+static void bench_connect(scaling_result_t* r, size_t size) {
+    ss_connection_t handles[BATCH];
+    int ops = ops_for_size(size);
+
+    begin_result(r, "connect", size);
+    for (int i = 0; i < ops; i += BATCH) {
+        uint64_t start = get_time_ns();
+        for (int j = 0; j < BATCH; j++) {
+            ss_connect_ex(name_at(g_samples[(i + j) % SAMPLE_COUNT]),
+                          empty_slot, NULL, SS_PRIORITY_NORMAL, &handles[j]);
+        }
+        record_batch(r, get_time_ns() - start, BATCH);
+        for (int j = 0; j < BATCH; j++) {
+            ss_disconnect_handle(handles[j]);
+        }
+    }
+}
+
+// Registering a new name pays for the duplicate check over the registry
+static void bench_register(scaling_result_t* r, size_t size) {
+    char probe[BATCH][NAME_LENGTH];
+    int ops = ops_for_size(size);
+
+    for (int j = 0; j < BATCH; j++) {
+        make_name(probe[j], size + (size_t)j, "_probe");
+    }
+    begin_result(r, "register", size);
+    for (int i = 0; i < ops; i += BATCH) {
+        uint64_t start = get_time_ns();
+        for (int j = 0; j < BATCH; j++) {
+            ss_signal_register(probe[j]);
+        }
+        record_batch(r, get_time_ns() - start, BATCH);
+        for (int j = 0; j < BATCH; j++) {
+            ss_signal_unregister(probe[j]);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    static const size_t sizes[] = { 10, 100, 1000, 10000, 100000 };
+    size_t max_signals = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10)
+                                  : DEFAULT_MAX_SIGNALS;
+    size_t registered = 0;
+
+    printf("SS_Lib Registry Scaling Benchmark\n");
+    printf("=================================\n\n");
+
+#if SS_USE_STATIC_MEMORY
+    // Leave room for the register probes
+    if (max_signals > SS_MAX_SIGNALS - BATCH) {
+        max_signals = SS_MAX_SIGNALS > BATCH ? SS_MAX_SIGNALS - BATCH : 0;
+    }
+#endif
+    if (max_signals < sizes[0]) {
+        fprintf(stderr, "Need room for at least %zu signals\n", sizes[0]);
+        return 1;
+    }
+
+    g_names = malloc(max_signals * NAME_LENGTH);
+    if (!g_names || ss_init() != SS_OK) {
+        fprintf(stderr, "Failed to initialize SS_Lib\n");
+        return 1;
+    }
+    for (size_t i = 0; i < max_signals; i++) {
+        make_name(g_names + i * NAME_LENGTH, i, "");
+    }
+    // Small registries see the same signal several times per connect batch
+    ss_set_max_slots_per_signal(BATCH + 1);
+
+    printf("Configuration:\n");
+    printf("  Max signals: %zu\n", max_signals);
+    printf("  Example name: %s\n\n", name_at(max_signals - 1));
+
+    printf("Results:\n");
+    printf("--------\n");
+    for (size_t s = 0; s < COUNT_OF(sizes) && sizes[s] <= max_signals; s++) {
+        scaling_result_t r;
+
+        if (!grow_registry(registered, sizes[s])) break;
+        registered = sizes[s];
+
+        bench_lookup_hit(&r, registered);
+        print_result(&r);
+        bench_lookup_miss(&r, registered);
+        print_result(&r);
+        bench_emit(&r, registered);
+        print_result(&r);
+        bench_connect(&r, registered);
+        print_result(&r);
+        bench_register(&r, registered);
+        print_result(&r);
+        fflush(stdout);
+    }
+
+    ss_cleanup();
+    free(g_names);
+    return 0;
+}
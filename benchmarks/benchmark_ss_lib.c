@@ -1,42 +1,27 @@
 #ifndef _WIN32
-#define _POSIX_C_SOURCE 200809L  /* For strdup on macOS */
-#define _GNU_SOURCE               /* For strdup on Linux */
+#define _POSIX_C_SOURCE 200809L  /* For clock_gettime on macOS */
+#define _GNU_SOURCE               /* For CPU pinning on Linux */
 #endif
 
+#define BENCH_HARNESS_IMPLEMENTATION
+#include "bench_harness.h"
+
 #include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
 #include <string.h>
-#include <sys/time.h>
 #include "ss_lib.h"
 
-#define BENCHMARK_ITERATIONS 1000000
-#define NUM_SLOTS 10
 #define NUM_SIGNALS 100
+#define MAX_BATCH 1024           // Cap for cases that stage per-op state
 
-// Timing utilities
-static inline uint64_t get_time_ns(void) {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
-}
-
-typedef struct {
-    const char* name;
-    uint64_t total_time;
-    uint64_t min_time;
-    uint64_t max_time;
-    int iterations;
-} benchmark_result_t;
-
-static void print_result(benchmark_result_t* result) {
-    uint64_t avg = result->total_time / result->iterations;
-    printf("%-40s: avg=%6llu ns, min=%6llu ns, max=%6llu ns\n",
-           result->name, 
-           (unsigned long long)avg,
-           (unsigned long long)result->min_time,
-           (unsigned long long)result->max_time);
-}
+// Static pools must hold a whole staged batch
+#if SS_USE_STATIC_MEMORY
+#define SIGNAL_BATCH (SS_MAX_SIGNALS / 2)
+#define SLOT_BATCH (SS_MAX_SLOTS / 2)
+#else
+#define SIGNAL_BATCH MAX_BATCH
+#define SLOT_BATCH MAX_BATCH
+#endif
 
 // Dummy slot functions
 static void empty_slot(const ss_data_t* data, void* user_data) {
@@ -45,11 +30,13 @@ static void empty_slot(const ss_data_t* data, void* user_data) {
 }
 
 static int counter = 0;
+#if SS_ENABLE_ISR_SAFE
 static void counting_slot(const ss_data_t* data, void* user_data) {
     (void)data;
     (void)user_data;
     counter++;
 }
+#endif
 
 static void data_slot(const ss_data_t* data, void* user_data) {
     (void)user_data;
@@ -58,336 +45,615 @@ static void data_slot(const ss_data_t* data, void* user_data) {
     }
 }
 
-// Benchmarks
-static void benchmark_signal_registration(benchmark_result_t* result) {
-    result->name = "Signal registration";
-    result->min_time = UINT64_MAX;
-    result->max_time = 0;
-    result->total_time = 0;
-    result->iterations = 1000;
-    
-    for (int i = 0; i < result->iterations; i++) {
-        char signal_name[32];
-        snprintf(signal_name, sizeof(signal_name), "bench_signal_%d", i);
-        
-        uint64_t start = get_time_ns();
-        ss_signal_register(signal_name);
-        uint64_t end = get_time_ns();
-        
-        uint64_t elapsed = end - start;
-        result->total_time += elapsed;
-        if (elapsed < result->min_time) result->min_time = elapsed;
-        if (elapsed > result->max_time) result->max_time = elapsed;
-    }
-}
-
-static void benchmark_slot_connection(benchmark_result_t* result) {
-    result->name = "Slot connection";
-    result->min_time = UINT64_MAX;
-    result->max_time = 0;
-    result->total_time = 0;
-    result->iterations = 10000;
-    
-    ss_signal_register("bench_connect");
-    
-    for (int i = 0; i < result->iterations; i++) {
-        uint64_t start = get_time_ns();
-        ss_connection_t handle;
-        ss_connect_ex("bench_connect", empty_slot, NULL, SS_PRIORITY_NORMAL, &handle);
-        uint64_t end = get_time_ns();
-        
-        uint64_t elapsed = end - start;
-        result->total_time += elapsed;
-        if (elapsed < result->min_time) result->min_time = elapsed;
-        if (elapsed > result->max_time) result->max_time = elapsed;
-        
-        ss_disconnect_handle(handle);
-    }
-}
-
-static void benchmark_emit_void(benchmark_result_t* result) {
-    result->name = "Emit void signal (no slots)";
-    result->min_time = UINT64_MAX;
-    result->max_time = 0;
-    result->total_time = 0;
-    result->iterations = BENCHMARK_ITERATIONS;
-    
-    ss_signal_register("bench_void");
-    
-    for (int i = 0; i < result->iterations; i++) {
-        uint64_t start = get_time_ns();
-        ss_emit_void("bench_void");
-        uint64_t end = get_time_ns();
-        
-        uint64_t elapsed = end - start;
-        result->total_time += elapsed;
-        if (elapsed < result->min_time) result->min_time = elapsed;
-        if (elapsed > result->max_time) result->max_time = elapsed;
-    }
-}
-
-static void benchmark_emit_with_slots(benchmark_result_t* result, int num_slots) {
-    char name[64];
-    snprintf(name, sizeof(name), "Emit void signal (%d slots)", num_slots);
-    result->name = strdup(name);
-    result->min_time = UINT64_MAX;
-    result->max_time = 0;
-    result->total_time = 0;
-    result->iterations = BENCHMARK_ITERATIONS / (num_slots > 0 ? num_slots : 1);
-    
-    ss_signal_register("bench_slots");
-    
-    // Connect slots
+// Shared per-case state; each case uses the fields it needs
+typedef struct {
+    const char* signal;
+    char names[MAX_BATCH][32];
+    ss_connection_t handles[MAX_BATCH];
+} bench_ctx_t;
+
+static bench_ctx_t g_ctx;
+
+// Registration: fresh names each batch, unregistered afterwards
+static void registration_setup(void* ctx, uint64_t iterations) {
+    bench_ctx_t* c = ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        snprintf(c->names[i], sizeof(c->names[i]), "bench_signal_%llu",
+                 (unsigned long long)i);
+    }
+}
+
+static void registration_run(void* ctx, uint64_t iterations) {
+    bench_ctx_t* c = ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_signal_register(c->names[i]);
+    }
+}
+
+static void registration_teardown(void* ctx, uint64_t iterations) {
+    bench_ctx_t* c = ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_signal_unregister(c->names[i]);
+    }
+}
+
+// Connection: connect a batch, then disconnect it untimed
+static void connection_run(void* ctx, uint64_t iterations) {
+    bench_ctx_t* c = ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_connect_ex(c->signal, empty_slot, NULL, SS_PRIORITY_NORMAL,
+                      &c->handles[i]);
+    }
+}
+
+static void disconnect_handles(void* ctx, uint64_t iterations) {
+    bench_ctx_t* c = ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_disconnect_handle(c->handles[i]);
+    }
+}
+
+// Disconnection: connect a batch untimed, then time the disconnects
+static void disconnect_setup(void* ctx, uint64_t iterations) {
+    connection_run(ctx, iterations);
+}
+
+static void lookup_run(void* ctx, uint64_t iterations) {
+    bench_ctx_t* c = ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_signal_exists(c->names[i % NUM_SIGNALS]);
+    }
+}
+
+static void emit_void_run(void* ctx, uint64_t iterations) {
+    const char* signal = ((bench_ctx_t*)ctx)->signal;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_emit_void(signal);
+    }
+}
+
+static void emit_int_run(void* ctx, uint64_t iterations) {
+    const char* signal = ((bench_ctx_t*)ctx)->signal;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_emit_int(signal, (int)i);
+    }
+}
+
+#if SS_ENABLE_ISR_SAFE
+// The ISR queue only holds SS_ISR_QUEUE_SIZE entries; drain it untimed
+static void isr_emit_run(void* ctx, uint64_t iterations) {
+    const char* signal = ((bench_ctx_t*)ctx)->signal;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_emit_from_isr(signal, (int)i);
+    }
+}
+
+static void isr_drain(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    (void)iterations;
+    ss_process_isr_queue();
+}
+#endif
+
+#if SS_ENABLE_ISR_SAFE
+// Drain cost per queued entry, slots included
+static void isr_fill(void* ctx, uint64_t iterations) {
+    isr_emit_run(ctx, iterations);
+}
+
+static void isr_drain_run(void* ctx, uint64_t iterations) {
+    isr_drain(ctx, iterations);
+}
+#endif
+
+// Payload mix for the queued and typed-data paths: mostly small scalars,
+// some short strings and a few larger structs, as UI and game events are
+#define PAYLOAD_MIX 20
+
+typedef struct {
+    float position[3];
+    float velocity[3];
+    uint32_t entity_id;
+    uint32_t flags;
+    char tag[24];
+} bench_event_t;                 // 56-byte custom payload
+
+static ss_data_t* g_payloads[PAYLOAD_MIX];
+
+static void payload_slot(const ss_data_t* data, void* user_data) {
+    (void)user_data;
+    if (!data) return;
+    switch (data->type) {
+    case SS_TYPE_INT:
+        counter += data->value.i_val;
+        break;
+    case SS_TYPE_STRING:
+        counter += data->value.s_val ? (int)strlen(data->value.s_val) : 0;
+        break;
+#if SS_ENABLE_CUSTOM_DATA
+    case SS_TYPE_CUSTOM: {
+        size_t size;
+        const bench_event_t* ev = ss_data_get_custom(data, &size);
+        if (ev) counter += (int)ev->entity_id;
+        break;
+    }
+#endif
+    default:
+        counter++;
+        break;
+    }
+}
+
+static void create_payloads(void) {
+    static const char* strings[] = {
+        "ready", "player_joined", "assets/textures/ui/button_hover.png"
+    };
+    static bench_event_t event = {
+        { 1.0f, 2.0f, 3.0f }, { 0.5f, 0.0f, -0.5f }, 42, 0x3, "collision"
+    };
+
+    for (int i = 0; i < PAYLOAD_MIX; i++) {
+        ss_data_t* d;
+        if (i < 8) {                       // 40% int
+            d = ss_data_create(SS_TYPE_INT);
+            ss_data_set_int(d, i);
+        } else if (i < 12) {               // 20% void
+            d = ss_data_create(SS_TYPE_VOID);
+        } else if (i < 15) {               // 15% float
+            d = ss_data_create(SS_TYPE_FLOAT);
+            ss_data_set_float(d, (float)i * 0.5f);
+        } else if (i < 18) {               // 15% string
+            d = ss_data_create(SS_TYPE_STRING);
+            ss_data_set_string(d, strings[i - 15]);
+        } else if (i < 19) {               // 5% pointer
+            d = ss_data_create(SS_TYPE_POINTER);
+            ss_data_set_pointer(d, &event);
+        } else {                           // 5% custom struct
+#if SS_ENABLE_CUSTOM_DATA
+            d = ss_data_create(SS_TYPE_CUSTOM);
+            ss_data_set_custom(d, &event, sizeof(event), NULL);
+#else
+            d = ss_data_create(SS_TYPE_INT);
+            ss_data_set_int(d, i);
+#endif
+        }
+        g_payloads[i] = d;
+    }
+}
+
+static void destroy_payloads(void) {
+    for (int i = 0; i < PAYLOAD_MIX; i++) {
+        ss_data_destroy(g_payloads[i]);
+    }
+}
+
+static void emit_mixed_run(void* ctx, uint64_t iterations) {
+    const char* signal = ((bench_ctx_t*)ctx)->signal;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_emit(signal, g_payloads[i % PAYLOAD_MIX]);
+    }
+}
+
+// Deferred queue: enqueue and flush separately, then the two combined
+static void deferred_enqueue_run(void* ctx, uint64_t iterations) {
+    const char* signal = ((bench_ctx_t*)ctx)->signal;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_emit_deferred(signal, g_payloads[i % PAYLOAD_MIX]);
+    }
+}
+
+static void deferred_flush_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    (void)iterations;
+    ss_flush_deferred();
+}
+
+static void deferred_cycle_run(void* ctx, uint64_t iterations) {
+    const char* signal = ((bench_ctx_t*)ctx)->signal;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_emit_deferred(signal, g_payloads[i % PAYLOAD_MIX]);
+        if ((i + 1) % SS_DEFERRED_QUEUE_SIZE == 0) ss_flush_deferred();
+    }
+    ss_flush_deferred();
+}
+
+// Batches hold SS_DEFERRED_QUEUE_SIZE entries unless SS_BATCH_MAX_ENTRIES
+// is overridden in the library build
+static ss_batch_t* g_batch;
+
+static void batch_add_run(void* ctx, uint64_t iterations) {
+    const char* signal = ((bench_ctx_t*)ctx)->signal;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_batch_add(g_batch, signal, g_payloads[i % PAYLOAD_MIX]);
+    }
+}
+
+static void batch_emit_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    (void)iterations;
+    ss_batch_emit(g_batch);
+}
+
+static void emit_namespaced_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_emit_namespaced("bench", "namespaced", NULL);
+    }
+}
+
+static void string_payload_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_data_t* d = ss_data_create(SS_TYPE_STRING);
+        ss_data_set_string(d, "player_joined");
+        ss_data_destroy(d);
+    }
+}
+
+#if SS_ENABLE_CUSTOM_DATA
+static void custom_payload_run(void* ctx, uint64_t iterations) {
+    bench_event_t event = { { 0 }, { 0 }, 7, 0, "spawn" };
+    (void)ctx;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ss_data_t* d = ss_data_create(SS_TYPE_CUSTOM);
+        event.entity_id = (uint32_t)i;
+        ss_data_set_custom(d, &event, sizeof(event), NULL);
+        ss_data_destroy(d);
+    }
+}
+#endif
+
+// Disconnect during emission: the first slot removes `victims` of the
+// others while the signal is emitting, so they are skipped and swept
+// after the emission. One emission per batch; setup rebuilds the slots.
+#define SWEEP_SLOTS 16
+
+typedef struct {
+    int victims;
+    ss_connection_t handles[SWEEP_SLOTS];
+} sweep_ctx_t;
+
+static void sweep_killer_slot(const ss_data_t* data, void* user_data) {
+    sweep_ctx_t* c = user_data;
+    (void)data;
+    for (int i = 0; i < c->victims; i++) {
+        ss_disconnect_handle(c->handles[i]);
+    }
+}
+
+static void sweep_setup(void* ctx, uint64_t iterations) {
+    sweep_ctx_t* c = ctx;
+    (void)iterations;
+    ss_connect_ex("bench_sweep", sweep_killer_slot, c, SS_PRIORITY_CRITICAL,
+                  NULL);
+    for (int i = 0; i < SWEEP_SLOTS - 1; i++) {
+        ss_connect_ex("bench_sweep", empty_slot, NULL, SS_PRIORITY_NORMAL,
+                      &c->handles[i]);
+    }
+}
+
+static void sweep_run(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    (void)iterations;
+    ss_emit_void("bench_sweep");
+}
+
+static void sweep_teardown(void* ctx, uint64_t iterations) {
+    (void)ctx;
+    (void)iterations;
+    ss_disconnect_all("bench_sweep");
+}
+
+// Run one case against `signal`; cases without staging leave the hooks NULL
+static void run_case(bench_suite_t* suite, const char* name, const char* signal,
+                     void (*run)(void*, uint64_t)) {
+    bench_case_t bench = { name, NULL, run, NULL, &g_ctx, 0 };
+    g_ctx.signal = signal;
+    bench_suite_run(suite, &bench);
+}
+
+static void register_with_slots(const char* signal, int num_slots,
+                                ss_slot_func_t slot) {
+    ss_signal_register(signal);
     for (int i = 0; i < num_slots; i++) {
-        ss_connect("bench_slots", empty_slot, NULL);
-    }
-    
-    counter = 0;
-    for (int i = 0; i < result->iterations; i++) {
-        uint64_t start = get_time_ns();
-        ss_emit_void("bench_slots");
-        uint64_t end = get_time_ns();
-        
-        uint64_t elapsed = end - start;
-        result->total_time += elapsed;
-        if (elapsed < result->min_time) result->min_time = elapsed;
-        if (elapsed > result->max_time) result->max_time = elapsed;
-    }
-    
-    ss_disconnect_all("bench_slots");
-}
-
-static void benchmark_emit_with_data(benchmark_result_t* result) {
-    result->name = "Emit int signal (5 slots)";
-    result->min_time = UINT64_MAX;
-    result->max_time = 0;
-    result->total_time = 0;
-    result->iterations = BENCHMARK_ITERATIONS / 5;
-    
-    ss_signal_register("bench_data");
-    
-    // Connect slots
-    for (int i = 0; i < 5; i++) {
-        ss_connect("bench_data", data_slot, NULL);
-    }
-    
-    counter = 0;
-    for (int i = 0; i < result->iterations; i++) {
-        uint64_t start = get_time_ns();
-        ss_emit_int("bench_data", i);
-        uint64_t end = get_time_ns();
-        
-        uint64_t elapsed = end - start;
-        result->total_time += elapsed;
-        if (elapsed < result->min_time) result->min_time = elapsed;
-        if (elapsed > result->max_time) result->max_time = elapsed;
-    }
-    
-    ss_disconnect_all("bench_data");
-}
-
-static void benchmark_priority_emit(benchmark_result_t* result) {
-    result->name = "Emit with priority slots (10 slots)";
-    result->min_time = UINT64_MAX;
-    result->max_time = 0;
-    result->total_time = 0;
-    result->iterations = BENCHMARK_ITERATIONS / 10;
-    
+        ss_connect(signal, slot, NULL);
+    }
+}
+
+// Emission cost with a given number of no-op slots
+static void benchmark_emit_with_slots(bench_suite_t* suite, int num_slots) {
+    char name[64];
+    if (num_slots == 0) {
+        snprintf(name, sizeof(name), "Emit void signal (no slots)");
+    } else {
+        snprintf(name, sizeof(name), "Emit void signal (%d slots)", num_slots);
+    }
+    register_with_slots("bench_slots", num_slots, empty_slot);
+    run_case(suite, name, "bench_slots", emit_void_run);
+    ss_signal_unregister("bench_slots");
+}
+
+static void benchmark_priority_emit(bench_suite_t* suite) {
+    static const ss_priority_t priorities[] = {
+        SS_PRIORITY_LOW, SS_PRIORITY_CRITICAL, SS_PRIORITY_NORMAL,
+        SS_PRIORITY_HIGH, SS_PRIORITY_NORMAL, SS_PRIORITY_LOW,
+        SS_PRIORITY_HIGH, SS_PRIORITY_CRITICAL, SS_PRIORITY_NORMAL,
+        SS_PRIORITY_LOW
+    };
+
     ss_signal_register("bench_priority");
-    
-    // Connect slots with different priorities
-    ss_connect_ex("bench_priority", empty_slot, NULL, SS_PRIORITY_LOW, NULL);
-    ss_connect_ex("bench_priority", empty_slot, NULL, SS_PRIORITY_CRITICAL, NULL);
-    ss_connect_ex("bench_priority", empty_slot, NULL, SS_PRIORITY_NORMAL, NULL);
-    ss_connect_ex("bench_priority", empty_slot, NULL, SS_PRIORITY_HIGH, NULL);
-    ss_connect_ex("bench_priority", empty_slot, NULL, SS_PRIORITY_NORMAL, NULL);
-    ss_connect_ex("bench_priority", empty_slot, NULL, SS_PRIORITY_LOW, NULL);
-    ss_connect_ex("bench_priority", empty_slot, NULL, SS_PRIORITY_HIGH, NULL);
-    ss_connect_ex("bench_priority", empty_slot, NULL, SS_PRIORITY_CRITICAL, NULL);
-    ss_connect_ex("bench_priority", empty_slot, NULL, SS_PRIORITY_NORMAL, NULL);
-    ss_connect_ex("bench_priority", empty_slot, NULL, SS_PRIORITY_LOW, NULL);
-    
-    for (int i = 0; i < result->iterations; i++) {
-        uint64_t start = get_time_ns();
-        ss_emit_void("bench_priority");
-        uint64_t end = get_time_ns();
-        
-        uint64_t elapsed = end - start;
-        result->total_time += elapsed;
-        if (elapsed < result->min_time) result->min_time = elapsed;
-        if (elapsed > result->max_time) result->max_time = elapsed;
-    }
-    
-    ss_disconnect_all("bench_priority");
-}
-
-static void benchmark_connection_handle(benchmark_result_t* result) {
-    result->name = "Disconnect using handle";
-    result->min_time = UINT64_MAX;
-    result->max_time = 0;
-    result->total_time = 0;
-    result->iterations = 10000;
-    
-    ss_signal_register("bench_handle");
-    
-    for (int i = 0; i < result->iterations; i++) {
-        ss_connection_t handle;
-        ss_connect_ex("bench_handle", empty_slot, NULL, SS_PRIORITY_NORMAL, &handle);
-        
-        uint64_t start = get_time_ns();
-        ss_disconnect_handle(handle);
-        uint64_t end = get_time_ns();
-        
-        uint64_t elapsed = end - start;
-        result->total_time += elapsed;
-        if (elapsed < result->min_time) result->min_time = elapsed;
-        if (elapsed > result->max_time) result->max_time = elapsed;
-    }
-}
-
-static void benchmark_signal_lookup(benchmark_result_t* result) {
-    result->name = "Signal existence check";
-    result->min_time = UINT64_MAX;
-    result->max_time = 0;
-    result->total_time = 0;
-    result->iterations = BENCHMARK_ITERATIONS;
-    
-    // Register many signals to stress the lookup
-    for (int i = 0; i < NUM_SIGNALS; i++) {
-        char name[32];
-        snprintf(name, sizeof(name), "lookup_signal_%d", i);
-        ss_signal_register(name);
-    }
-    
-    for (int i = 0; i < result->iterations; i++) {
-        int idx = i % NUM_SIGNALS;
-        char name[32];
-        snprintf(name, sizeof(name), "lookup_signal_%d", idx);
-        
-        uint64_t start = get_time_ns();
-        ss_signal_exists(name);
-        uint64_t end = get_time_ns();
-        
-        uint64_t elapsed = end - start;
-        result->total_time += elapsed;
-        if (elapsed < result->min_time) result->min_time = elapsed;
-        if (elapsed > result->max_time) result->max_time = elapsed;
+    for (size_t i = 0; i < sizeof(priorities) / sizeof(priorities[0]); i++) {
+        ss_connect_ex("bench_priority", empty_slot, NULL, priorities[i], NULL);
     }
+    run_case(suite, "Emit with priority slots (10 slots)", "bench_priority",
+             emit_void_run);
+    ss_signal_unregister("bench_priority");
 }
 
-#if SS_ENABLE_ISR_SAFE
-static void benchmark_isr_emit(benchmark_result_t* result) {
-    result->name = "ISR-safe emit (5 slots)";
-    result->min_time = UINT64_MAX;
-    result->max_time = 0;
-    result->total_time = 0;
-    result->iterations = BENCHMARK_ITERATIONS / 5;
-    
-    ss_signal_register("bench_isr");
-    
-    // Connect slots
-    for (int i = 0; i < 5; i++) {
-        ss_connect("bench_isr", counting_slot, NULL);
-    }
-    
-    counter = 0;
-    for (int i = 0; i < result->iterations; i++) {
-        uint64_t start = get_time_ns();
-        ss_emit_from_isr("bench_isr", i);
-        uint64_t end = get_time_ns();
-        
-        uint64_t elapsed = end - start;
-        result->total_time += elapsed;
-        if (elapsed < result->min_time) result->min_time = elapsed;
-        if (elapsed > result->max_time) result->max_time = elapsed;
-    }
-    
-    ss_disconnect_all("bench_isr");
+// Dispatch-path cost per configuration: a 1-slot int emission
+static void benchmark_emit_path(bench_suite_t* suite, const char* name,
+                                int thread_safe, int profiling) {
+    if (!ss_signal_exists("bench_path")) {
+        register_with_slots("bench_path", 1, data_slot);
+    }
+#if SS_ENABLE_THREAD_SAFETY
+    ss_set_thread_safe(thread_safe);
+#else
+    (void)thread_safe;
+#endif
+#if SS_ENABLE_PERFORMANCE_STATS
+    ss_enable_profiling(profiling);
+#else
+    (void)profiling;
+#endif
+    run_case(suite, name, "bench_path", emit_int_run);
+#if SS_ENABLE_PERFORMANCE_STATS
+    ss_enable_profiling(0);
+#endif
+#if SS_ENABLE_THREAD_SAFETY
+    ss_set_thread_safe(0);
+#endif
+}
+
+// Queued paths with the mixed payloads: per-entry enqueue, flush and
+// batch costs, and the end-to-end deferred cycle
+static void benchmark_queued_paths(bench_suite_t* suite) {
+    bench_case_t bench = { NULL, NULL, NULL, NULL, &g_ctx,
+                           SS_DEFERRED_QUEUE_SIZE };
+
+    register_with_slots("bench_queued", 1, payload_slot);
+    g_ctx.signal = "bench_queued";
+
+    bench.name = "Deferred enqueue (mixed payloads)";
+    bench.run = deferred_enqueue_run;
+    bench.teardown = deferred_flush_run;
+    bench_suite_run(suite, &bench);
+
+    bench.name = "Deferred flush/entry (mixed payloads)";
+    bench.setup = deferred_enqueue_run;
+    bench.run = deferred_flush_run;
+    bench.teardown = NULL;
+    bench_suite_run(suite, &bench);
+
+    bench.name = "Deferred emit + flush (mixed payloads)";
+    bench.setup = NULL;
+    bench.run = deferred_cycle_run;
+    bench.max_batch = 0;
+    bench_suite_run(suite, &bench);
+
+    g_batch = ss_batch_create();
+    if (g_batch) {
+        bench.name = "Batch add (mixed payloads)";
+        bench.run = batch_add_run;
+        bench.teardown = batch_emit_run;
+        bench.max_batch = SS_DEFERRED_QUEUE_SIZE;
+        bench_suite_run(suite, &bench);
+
+        bench.name = "Batch emit/entry (mixed payloads)";
+        bench.setup = batch_add_run;
+        bench.run = batch_emit_run;
+        bench.teardown = NULL;
+        bench_suite_run(suite, &bench);
+        ss_batch_destroy(g_batch);
+    }
+
+    run_case(suite, "Emit mixed payloads (1 slot)", "bench_queued",
+             emit_mixed_run);
+    ss_signal_unregister("bench_queued");
+}
+
+static void benchmark_disconnect_sweep(bench_suite_t* suite, int victims) {
+    static sweep_ctx_t sweep;
+    char name[64];
+    bench_case_t bench = { name, sweep_setup, sweep_run, sweep_teardown,
+                           &sweep, 1 };
+
+    snprintf(name, sizeof(name), "Emit %d slots, %d dropped mid-emit",
+             SWEEP_SLOTS, victims);
+    sweep.victims = victims;
+    ss_signal_register("bench_sweep");
+    bench_suite_run(suite, &bench);
+    ss_signal_unregister("bench_sweep");
+}
+
+#if SS_ENABLE_PERFORMANCE_STATS
+// Profiling overhead: the same 1-slot emission with profiling off, and on
+// with each clock source
+static void benchmark_profiling_overhead(bench_suite_t* suite, const char* name,
+                                         int profiling,
+                                         ss_clock_source_t source) {
+    if (!ss_signal_exists("bench_profile")) {
+        register_with_slots("bench_profile", 1, empty_slot);
+    }
+    ss_set_clock_source(source);
+    ss_enable_profiling(profiling);
+    run_case(suite, name, "bench_profile", emit_void_run);
+    ss_enable_profiling(0);
+    ss_set_clock_source(SS_CLOCK_DEFAULT);
 }
 #endif
 
-int main(void) {
+int main(int argc, char** argv) {
+    static bench_suite_t suite;
+
+    if (bench_suite_init(&suite, "ss_lib", argc, argv) != 0) {
+        return 1;
+    }
+
     printf("SS_Lib Benchmark Suite\n");
     printf("======================\n\n");
-    
+
     // Initialize library
     if (ss_init() != SS_OK) {
         fprintf(stderr, "Failed to initialize SS_Lib\n");
         return 1;
     }
-    
+    ss_set_max_slots_per_signal(MAX_BATCH + 1);
+
     printf("Configuration:\n");
 #if SS_USE_STATIC_MEMORY
-    printf("  Memory: Static (MAX_SIGNALS=%d, MAX_SLOTS=%d)\n", 
+    printf("  Memory: Static (MAX_SIGNALS=%d, MAX_SLOTS=%d)\n",
            SS_MAX_SIGNALS, SS_MAX_SLOTS);
+    bench_suite_info(&suite, "memory", "static");
 #else
     printf("  Memory: Dynamic\n");
+    bench_suite_info(&suite, "memory", "dynamic");
 #endif
 #if SS_ENABLE_THREAD_SAFETY
     printf("  Thread Safety: Enabled\n");
+    bench_suite_info(&suite, "thread_safety", "1");
 #else
     printf("  Thread Safety: Disabled\n");
+    bench_suite_info(&suite, "thread_safety", "0");
 #endif
 #if SS_ENABLE_ISR_SAFE
     printf("  ISR Safe: Enabled\n");
+    bench_suite_info(&suite, "isr_safe", "1");
 #else
     printf("  ISR Safe: Disabled\n");
+    bench_suite_info(&suite, "isr_safe", "0");
 #endif
+    bench_suite_print_config(&suite);
     printf("\n");
-    
-    // Run benchmarks
-    benchmark_result_t results[20];
-    int num_results = 0;
-    
-    printf("Running benchmarks...\n\n");
-    
+
+    printf("Results (ns per operation):\n");
+    printf("---------------------------\n");
+
     // Basic operations
-    benchmark_signal_registration(&results[num_results++]);
-    benchmark_slot_connection(&results[num_results++]);
-    benchmark_signal_lookup(&results[num_results++]);
-    benchmark_connection_handle(&results[num_results++]);
-    
+    {
+        bench_case_t bench = { "Signal registration", registration_setup,
+                               registration_run, registration_teardown,
+                               &g_ctx, SIGNAL_BATCH };
+        bench_suite_run(&suite, &bench);
+    }
+
+    ss_signal_register("bench_connect");
+    {
+        bench_case_t bench = { "Slot connection", NULL, connection_run,
+                               disconnect_handles, &g_ctx, SLOT_BATCH };
+        g_ctx.signal = "bench_connect";
+        bench_suite_run(&suite, &bench);
+    }
+
+    // Register many signals to stress the lookup
+    for (int i = 0; i < NUM_SIGNALS; i++) {
+        snprintf(g_ctx.names[i], sizeof(g_ctx.names[i]), "lookup_signal_%d", i);
+        ss_signal_register(g_ctx.names[i]);
+    }
+    run_case(&suite, "Signal existence check", NULL, lookup_run);
+
+    {
+        bench_case_t bench = { "Disconnect using handle", disconnect_setup,
+                               disconnect_handles, NULL, &g_ctx, SLOT_BATCH };
+        g_ctx.signal = "bench_connect";
+        bench_suite_run(&suite, &bench);
+    }
+
     // Emission benchmarks
-    benchmark_emit_void(&results[num_results++]);
-    benchmark_emit_with_slots(&results[num_results++], 1);
-    benchmark_emit_with_slots(&results[num_results++], 5);
-    benchmark_emit_with_slots(&results[num_results++], 10);
-    benchmark_emit_with_data(&results[num_results++]);
-    benchmark_priority_emit(&results[num_results++]);
-    
+    benchmark_emit_with_slots(&suite, 0);
+    benchmark_emit_with_slots(&suite, 1);
+    benchmark_emit_with_slots(&suite, 5);
+    benchmark_emit_with_slots(&suite, 10);
+
+    register_with_slots("bench_data", 5, data_slot);
+    run_case(&suite, "Emit int signal (5 slots)", "bench_data", emit_int_run);
+
+    benchmark_priority_emit(&suite);
+
 #if SS_ENABLE_ISR_SAFE
-    benchmark_isr_emit(&results[num_results++]);
+    register_with_slots("bench_isr", 5, counting_slot);
+    {
+        bench_case_t bench = { "ISR-safe emit (5 slots)", NULL, isr_emit_run,
+                               isr_drain, &g_ctx, SS_ISR_QUEUE_SIZE };
+        g_ctx.signal = "bench_isr";
+        bench_suite_run(&suite, &bench);
+    }
+    {
+        bench_case_t bench = { "ISR queue drain/entry (5 slots)", isr_fill,
+                               isr_drain_run, NULL, &g_ctx, SS_ISR_QUEUE_SIZE };
+        g_ctx.signal = "bench_isr";
+        bench_suite_run(&suite, &bench);
+    }
+#endif
+
+    // Queued, namespaced and typed-payload paths
+    create_payloads();
+    benchmark_queued_paths(&suite);
+
+    register_with_slots("bench::namespaced", 1, empty_slot);
+    run_case(&suite, "Emit namespaced (1 slot)", NULL, emit_namespaced_run);
+    ss_signal_unregister("bench::namespaced");
+
+    run_case(&suite, "String payload create/set/destroy", NULL,
+             string_payload_run);
+#if SS_ENABLE_CUSTOM_DATA
+    run_case(&suite, "Custom payload create/set/destroy (56 B)", NULL,
+             custom_payload_run);
+#endif
+    destroy_payloads();
+
+    // Deferred removal and sweep when slots disconnect mid-emission
+    benchmark_disconnect_sweep(&suite, 0);
+    benchmark_disconnect_sweep(&suite, 1);
+    benchmark_disconnect_sweep(&suite, 4);
+    benchmark_disconnect_sweep(&suite, SWEEP_SLOTS - 1);
+
+    // Dispatch path selected by runtime settings
+    benchmark_emit_path(&suite, "Emit path (unlocked)", 0, 0);
+#if SS_ENABLE_THREAD_SAFETY
+    benchmark_emit_path(&suite, "Emit path (locked)", 1, 0);
+#endif
+#if SS_ENABLE_PERFORMANCE_STATS
+    benchmark_emit_path(&suite, "Emit path (profiled)", 0, 1);
+#endif
+
+#if SS_ENABLE_PERFORMANCE_STATS
+    // Profiling overhead per clock source
+    benchmark_profiling_overhead(&suite, "Emit (profiling off)", 0,
+                                 SS_CLOCK_DEFAULT);
+    benchmark_profiling_overhead(&suite, "Emit (profiling, monotonic clock)",
+                                 1, SS_CLOCK_MONOTONIC);
+    if (ss_set_clock_source(SS_CLOCK_TSC) == SS_OK) {
+        benchmark_profiling_overhead(&suite, "Emit (profiling, TSC clock)", 1,
+                                     SS_CLOCK_TSC);
+    } else {
+        printf("TSC clock unavailable, skipping TSC profiling benchmark\n");
+    }
 #endif
-    
-    // Print results
-    printf("Results:\n");
-    printf("--------\n");
-    for (int i = 0; i < num_results; i++) {
-        print_result(&results[i]);
-    }
-    
+
     // Memory statistics
 #if SS_ENABLE_MEMORY_STATS
     printf("\nMemory Statistics:\n");
     ss_memory_stats_t stats;
     if (ss_get_memory_stats(&stats) == SS_OK) {
-        printf("  Signals: %zu used, %zu allocated\n", 
+        printf("  Signals: %zu used, %zu allocated\n",
                stats.signals_used, stats.signals_allocated);
         printf("  Slots: %zu used, %zu allocated\n",
                stats.slots_used, stats.slots_allocated);
-        printf("  Total memory: %zu bytes\n", stats.total_bytes);
+        printf("  Total memory: %zu bytes\n", stats.total_bytes_allocated);
     }
 #endif
-    
+
     ss_cleanup();
-    
-    // Free allocated names (only those created with strdup)
-    for (int i = 0; i < num_results; i++) {
-        if (strstr(results[i].name, "Emit void signal (") == results[i].name &&
-            strcmp(results[i].name, "Emit void signal (no slots)") != 0) {
-            free((void*)results[i].name);
-        }
-    }
-    
-    return 0;
-}
\ No newline at end of file
+    return bench_suite_finish(&suite) == 0 ? 0 : 1;
+}
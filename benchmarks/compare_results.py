@@ -0,0 +1,221 @@
+#!/usr/bin/env python3
+"""
+Benchmark comparison tool for SS_Lib
+Diffs JSON results written by the benchmark harness (--json=PATH)
+
+Usage:
+    compare_results.py BASE.json NEW.json   Flag regressions between two runs
+    compare_results.py BASE_DIR NEW_DIR     Same, for every JSON file in both
+    compare_results.py DIR                  Side-by-side table of every
+                                            configuration in DIR
+
+A benchmark counts as changed only when its median moved by more than
+--threshold percent AND by more than --noise times the combined run-to-run
+spread (MAD scaled to a standard deviation). Footprint results
+(benchmark_memory) are exact values, so any growth beyond
+--size-threshold percent counts. --counter=NAME compares a per-operation
+hardware counter (instructions, cycles, l1d_misses, llc_misses,
+branch_misses) instead of time, against --threshold alone. Exits with
+status 1 when any benchmark regressed.
+"""
+
+import argparse
+import json
+import math
+import os
+import sys
+
+# Scales a median absolute deviation to a normal standard deviation
+MAD_TO_SIGMA = 1.4826
+
+
+def load_results(path, counter=None):
+    """Load one harness JSON file into {benchmark name: result}
+
+    With `counter`, each timed result becomes an exact value holding that
+    per-operation counter; results without it are left out.
+    """
+    with open(path, 'r') as f:
+        data = json.load(f)
+    results = {r['name']: r for r in data.get('results', [])}
+    if counter:
+        results = {name: {'name': name, 'value': r['counters'][counter],
+                          'counter': counter}
+                   for name, r in results.items()
+                   if counter in r.get('counters', {})}
+    return data, results
+
+
+def json_files(directory):
+    """JSON result files in a directory, keyed by file name"""
+    return {name: os.path.join(directory, name)
+            for name in sorted(os.listdir(directory))
+            if name.endswith('.json')}
+
+
+def metric(result):
+    """Timed results compare medians; footprint results exact values"""
+    return result['median_ns'] if 'median_ns' in result else result['value']
+
+
+def format_metric(result):
+    if 'median_ns' in result:
+        return f"{result['median_ns']:.1f} ±{result.get('mad_ns', 0):.1f}"
+    return f"{result['value']:.1f}"
+
+
+def classify(base, new, args):
+    """Return (change %, status) for one benchmark"""
+    b = metric(base)
+    n = metric(new)
+    if 'median_ns' not in base:
+        # Exact counts: no noise, and growth from zero still matters
+        if n == b:
+            return 0.0, 'noise'
+        change = (n - b) / abs(b) * 100 if b else math.copysign(math.inf, n - b)
+        limit = args.threshold if 'counter' in base else args.size_threshold
+        if abs(change) <= limit:
+            return change, 'noise'
+        return change, 'REGRESSION' if n > b else 'improvement'
+    if b <= 0:
+        return 0.0, 'n/a'
+
+    change = (n - b) / b * 100
+    sigma = MAD_TO_SIGMA * math.sqrt(base.get('mad_ns', 0) ** 2 +
+                                     new.get('mad_ns', 0) ** 2)
+    significant = (abs(n - b) > args.noise * sigma and
+                   abs(change) > args.threshold)
+
+    if not significant:
+        return change, 'noise'
+    return change, 'REGRESSION' if change > 0 else 'improvement'
+
+
+def compare_pair(base_path, new_path, args, out):
+    """Print the comparison of two result files; return the regression count"""
+    _, base = load_results(base_path, args.counter)
+    _, new = load_results(new_path, args.counter)
+    regressions = 0
+
+    if args.markdown:
+        out.write(f"\n### {os.path.basename(new_path)}\n\n")
+        out.write("| Benchmark | Base | Current | Change | Status |\n")
+        out.write("|-----------|-----------|--------------|--------|--------|\n")
+    else:
+        out.write(f"\n{base_path} -> {new_path}\n")
+        out.write(f"{'Benchmark':<40} {'Base':>12} {'New':>12} "
+                  f"{'Change':>8}  Status\n")
+
+    # Keep the order the suite ran in, then anything that only one side has
+    names = list(base.keys()) + [name for name in new if name not in base]
+    for name in names:
+        if name in base and name in new:
+            b = base[name]
+            n = new[name]
+            change, status = classify(b, n, args)
+            if status == 'REGRESSION':
+                regressions += 1
+            base_col = format_metric(b)
+            new_col = format_metric(n)
+            change_col = f"{change:+.1f}%"
+        elif name in base:
+            base_col, new_col, change_col, status = (
+                f"{metric(base[name]):.1f}", 'N/A', '-', 'removed')
+        else:
+            base_col, new_col, change_col, status = (
+                'N/A', f"{metric(new[name]):.1f}", '-', 'added')
+
+        if args.markdown:
+            out.write(f"| {name} | {base_col} | {new_col} | {change_col} "
+                      f"| {status} |\n")
+        else:
+            out.write(f"{name:<40} {base_col:>12} {new_col:>12} "
+                      f"{change_col:>8}  {status}\n")
+
+    return regressions
+
+
+def summarize_directory(directory, args, out):
+    """Side-by-side medians for every configuration in one directory"""
+    files = json_files(directory)
+    if not files:
+        sys.stderr.write(f"No JSON results in {directory}\n")
+        return 1
+
+    configs = []
+    names = []
+    footprint = False
+    for file_name, path in files.items():
+        _, results = load_results(path, args.counter)
+        footprint = footprint or any('value' in r for r in results.values())
+        label = os.path.splitext(file_name)[0].replace(
+            'benchmark_', '').replace('footprint_', '')
+        configs.append((label, results))
+        for name in results:
+            if name not in names:
+                names.append(name)
+
+    sep = ' | ' if args.markdown else '  '
+    if args.counter:
+        title = f"Benchmark ({args.counter}/op)"
+    else:
+        title = 'Footprint' if footprint else 'Benchmark (median ns)'
+    header = [f"{title:<40}"] + [f"{label:>12}" for label, _ in configs]
+    out.write(sep.join(header) + '\n')
+    if args.markdown:
+        out.write(sep.join(['---'] * len(header)) + '\n')
+    for name in names:
+        row = [f"{name:<40}"]
+        for _, results in configs:
+            r = results.get(name)
+            row.append(f"{metric(r):>12.1f}" if r else f"{'-':>12}")
+        out.write(sep.join(row) + '\n')
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compare SS_Lib benchmark JSON results')
+    parser.add_argument('base', help='JSON file or directory')
+    parser.add_argument('new', nargs='?', help='JSON file or directory')
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help='minimum change in percent (default 5)')
+    parser.add_argument('--noise', type=float, default=3.0,
+                        help='minimum change in combined sigmas (default 3)')
+    parser.add_argument('--size-threshold', type=float, default=0.0,
+                        help='minimum footprint change in percent (default 0)')
+    parser.add_argument('--counter', metavar='NAME',
+                        help='compare a per-op hardware counter instead of time')
+    parser.add_argument('--markdown', action='store_true',
+                        help='print Markdown tables')
+    args = parser.parse_args()
+    out = sys.stdout
+
+    if args.new is None:
+        if not os.path.isdir(args.base):
+            parser.error('a single argument must be a directory')
+        return summarize_directory(args.base, args, out)
+
+    if os.path.isdir(args.base) and os.path.isdir(args.new):
+        base_files = json_files(args.base)
+        new_files = json_files(args.new)
+        pairs = [(base_files[n], new_files[n])
+                 for n in base_files if n in new_files]
+        if not pairs:
+            sys.stderr.write('No result files in common\n')
+            return 1
+    else:
+        pairs = [(args.base, args.new)]
+
+    regressions = 0
+    for base_path, new_path in pairs:
+        regressions += compare_pair(base_path, new_path, args, out)
+
+    out.write(f"\n{regressions} regression(s) beyond noise "
+              f"(>{args.threshold:g}% and >{args.noise:g} sigma; "
+              f"footprint >{args.size_threshold:g}%)\n")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
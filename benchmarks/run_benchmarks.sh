@@ -2,6 +2,10 @@
 
 # Benchmark runner for SS_Lib
 # Compares performance across different configurations
+#
+# Each configuration writes build/benchmarks/benchmark_<name>.json. Set
+# BASELINE_DIR to a previous results directory to flag regressions, and
+# BENCH_ARGS to pass harness options (e.g. "--quick --cpu=2").
 
 set -e
 
@@ -31,6 +35,26 @@ run_benchmark() {
     
     echo "Running benchmark: $name"
     echo "----------------------------------------"
+    "$output" $BENCH_ARGS --json="$output.json"
+    echo ""
+}
+
+# Multithreaded contention suite; only meaningful with thread safety on
+run_mt_benchmark() {
+    local name="$1"
+    local flags="$2"
+    local output="$BUILD_DIR/benchmark_mt_$name"
+
+    echo "Building multithreaded benchmark: $name"
+    gcc -O3 -march=native $flags \
+        -I"$PROJECT_DIR/include" \
+        "$SCRIPT_DIR/benchmark_mt.c" \
+        "$PROJECT_DIR/src/ss_lib.c" \
+        -pthread \
+        -o "$output"
+
+    echo "Running multithreaded benchmark: $name"
+    echo "----------------------------------------"
     "$output"
     echo ""
 }
@@ -40,6 +64,8 @@ run_benchmark "dynamic_mt" "-DSS_ENABLE_THREAD_SAFETY=1"
 run_benchmark "dynamic_st" "-DSS_ENABLE_THREAD_SAFETY=0"
 run_benchmark "static_mt" "-DSS_USE_STATIC_MEMORY=1 -DSS_MAX_SIGNALS=256 -DSS_MAX_SLOTS=1024 -DSS_ENABLE_THREAD_SAFETY=1"
 run_benchmark "static_st" "-DSS_USE_STATIC_MEMORY=1 -DSS_MAX_SIGNALS=256 -DSS_MAX_SLOTS=1024 -DSS_ENABLE_THREAD_SAFETY=0"
+run_mt_benchmark "dynamic_mt" "-DSS_ENABLE_THREAD_SAFETY=1"
+run_mt_benchmark "static_mt" "-DSS_USE_STATIC_MEMORY=1 -DSS_MAX_SIGNALS=256 -DSS_MAX_SLOTS=1024 -DSS_ENABLE_THREAD_SAFETY=1"
 run_benchmark "minimal" "-DSS_MINIMAL_BUILD -DSS_USE_STATIC_MEMORY=1 -DSS_MAX_SIGNALS=32 -DSS_MAX_SLOTS=128"
 
 # If ISR-safe is available
@@ -53,4 +79,12 @@ echo "Generating comparison report..."
     echo "Note: Python comparison script not found or failed. Raw results are in $BUILD_DIR"
 }
 
+if [ -n "$BASELINE_DIR" ]; then
+    echo "Comparing against baseline: $BASELINE_DIR"
+    if ! "$SCRIPT_DIR/compare_results.py" "$BASELINE_DIR" "$BUILD_DIR" > "$BUILD_DIR/regression_report.txt"; then
+        echo "Regressions beyond noise found"
+    fi
+    cat "$BUILD_DIR/regression_report.txt"
+fi
+
 echo "Benchmark complete! Results saved to: $BUILD_DIR"
\ No newline at end of file
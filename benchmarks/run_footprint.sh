@@ -0,0 +1,68 @@
+#!/bin/bash
+
+# Memory footprint runner for SS_Lib
+# Measures each build configuration's library object size and runtime heap
+# use, writing build/footprint/footprint_<name>.json.
+#
+# Set BASELINE_DIR to a previous footprint directory to flag growth, and
+# OPT to change the optimization level the object is sized at (default -O2).
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(dirname "$SCRIPT_DIR")"
+BUILD_DIR="$PROJECT_DIR/build/footprint"
+OPT="${OPT:--O2}"
+
+mkdir -p "$BUILD_DIR"
+
+echo "SS_Lib Memory Footprint"
+echo "======================="
+echo ""
+
+run_footprint() {
+    local name="$1"
+    local flags="$2"
+    local object="$BUILD_DIR/ss_lib_$name.o"
+    local output="$BUILD_DIR/footprint_$name"
+    local sections=""
+
+    echo "Building footprint: $name"
+    gcc $OPT $flags -I"$PROJECT_DIR/include" \
+        -c "$PROJECT_DIR/src/ss_lib.c" -o "$object"
+    gcc $OPT $flags -I"$PROJECT_DIR/include" \
+        "$SCRIPT_DIR/benchmark_memory.c" -pthread -o "$output"
+
+    # Berkeley format: text data bss dec hex filename
+    if command -v size >/dev/null 2>&1; then
+        sections=$(size "$object" | awk 'NR == 2 {
+            printf "--text=%s --data=%s --bss=%s", $1, $2, $3 }')
+    fi
+
+    "$output" --config="$name" $sections --json="$output.json"
+    echo ""
+}
+
+run_footprint "full" "-DSS_ENABLE_ISR_SAFE=1 -DSS_ENABLE_MEMORY_STATS=1 -DSS_ENABLE_PERFORMANCE_STATS=1 \
+    -DSS_ENABLE_TRACE_BUFFER=1 -DSS_ENABLE_QUEUE_STATS=1 -DSS_ENABLE_ALLOC_HISTOGRAM=1 -DSS_ENABLE_HOOKS=1 \
+    -DSS_ENABLE_HOT_SIGNALS=1 -DSS_ENABLE_WASTE_STATS=1 -DSS_ENABLE_CALL_GRAPH=1 -DSS_ENABLE_THREAD_STATS=1"
+run_footprint "default" ""
+run_footprint "dynamic_st" "-DSS_ENABLE_THREAD_SAFETY=0"
+run_footprint "static" "-DSS_USE_STATIC_MEMORY=1 -DSS_MAX_SIGNALS=256 -DSS_MAX_SLOTS=1024"
+run_footprint "minimal" "-DSS_MINIMAL_BUILD -DSS_USE_STATIC_MEMORY=1 -DSS_MAX_SIGNALS=32 -DSS_MAX_SLOTS=128"
+run_footprint "embedded" "-DSS_EMBEDDED_BUILD"
+
+echo "Generating footprint report..."
+"$SCRIPT_DIR/compare_results.py" "$BUILD_DIR" > "$BUILD_DIR/footprint_report.txt"
+cat "$BUILD_DIR/footprint_report.txt"
+
+if [ -n "$BASELINE_DIR" ]; then
+    echo ""
+    echo "Comparing against baseline: $BASELINE_DIR"
+    if ! "$SCRIPT_DIR/compare_results.py" "$BASELINE_DIR" "$BUILD_DIR" > "$BUILD_DIR/regression_report.txt"; then
+        echo "Footprint grew"
+    fi
+    cat "$BUILD_DIR/regression_report.txt"
+fi
+
+echo "Footprint complete! Results saved to: $BUILD_DIR"
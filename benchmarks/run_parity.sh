@@ -0,0 +1,133 @@
+#!/bin/bash
+
+# Implementation parity runner for SS_Lib
+# Builds benchmark_ss_lib and benchmark_baseline against each implementation
+# with the same configuration flags and compiler options:
+#
+#   c11     src/ss_lib.c
+#   c89     src/ss_lib_c89.c, compiled with -std=c89
+#   single  the single header create_single_header.sh generates (what
+#           releases ship), compiled from one SS_IMPLEMENTATION file
+#
+# Each variant is built as one object and linked the same way, so only the
+# implementation differs. Results go to build/parity/<config>/<suite>/
+# <variant>.json, with a side-by-side table per suite and a report of the
+# c89 and single results against c11 in build/parity/parity_report.txt.
+# The report also lists each object's text/data/bss. When the single
+# header's sections match c11 it compiled to the same code, and any timing
+# gap between the two is run-to-run and code-layout noise; the baseline
+# cases, which never call the library, show the same noise.
+#
+# Instrumentation stays off: the C89 version has no latency histograms,
+# clock sources or ISR queue draining, so those cases are not comparable.
+# Set BENCH_ARGS to pass harness options (e.g. "--quick").
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(dirname "$SCRIPT_DIR")"
+BUILD_DIR="$PROJECT_DIR/build/parity"
+SINGLE_DIR="$BUILD_DIR/single_header"
+OPT="${OPT:--O3}"
+VARIANTS="c11 c89 single"
+SUITES="ss_lib baseline"
+REPORT="$BUILD_DIR/parity_report.txt"
+
+mkdir -p "$SINGLE_DIR"
+
+echo "SS_Lib Implementation Parity"
+echo "============================"
+echo ""
+
+# The single header as released, plus an "ss_lib.h" that forwards to it so
+# the benchmarks compile unchanged against its own declarations
+"$PROJECT_DIR/create_single_header.sh" "$SINGLE_DIR/ss_lib_single.h" >/dev/null
+echo '#include "ss_lib_single.h"' > "$SINGLE_DIR/ss_lib.h"
+printf '#define SS_IMPLEMENTATION\n#include "ss_lib_single.h"\n' \
+    > "$SINGLE_DIR/ss_lib_single.c"
+
+# Compile one implementation to $dir/ss_lib.o; sets INCLUDES for the suites
+build_variant() {
+    local variant="$1"
+    local flags="$2"
+    local dir="$3"
+
+    case "$variant" in
+    c11)
+        INCLUDES="-I$PROJECT_DIR/include"
+        gcc $OPT -std=c11 $flags $INCLUDES -c "$PROJECT_DIR/src/ss_lib.c" \
+            -o "$dir/ss_lib.o"
+        ;;
+    c89)
+        INCLUDES="-I$PROJECT_DIR/include"
+        gcc $OPT -std=c89 $flags $INCLUDES -c "$PROJECT_DIR/src/ss_lib_c89.c" \
+            -o "$dir/ss_lib.o"
+        ;;
+    single)
+        INCLUDES="-I$SINGLE_DIR"
+        gcc $OPT -std=c11 $flags $INCLUDES -c "$SINGLE_DIR/ss_lib_single.c" \
+            -o "$dir/ss_lib.o"
+        ;;
+    esac
+}
+
+run_parity() {
+    local name="$1"
+    local flags="$2"
+    local variant suite dir
+
+    for variant in $VARIANTS; do
+        dir="$BUILD_DIR/$name/$variant"
+        mkdir -p "$dir"
+        echo "Building $name: $variant"
+        build_variant "$variant" "$flags" "$dir"
+        for suite in $SUITES; do
+            mkdir -p "$BUILD_DIR/$name/$suite"
+            gcc $OPT -std=c11 $flags $INCLUDES \
+                "$SCRIPT_DIR/benchmark_$suite.c" "$dir/ss_lib.o" \
+                -pthread -lm -o "$dir/benchmark_$suite"
+            echo "Running $name: $variant, benchmark_$suite"
+            echo "----------------------------------------"
+            "$dir/benchmark_$suite" $BENCH_ARGS \
+                --json="$BUILD_DIR/$name/$suite/$variant.json"
+            echo ""
+        done
+    done
+}
+
+run_parity "dynamic_mt" "-DSS_ENABLE_THREAD_SAFETY=1"
+run_parity "dynamic_st" "-DSS_ENABLE_THREAD_SAFETY=0"
+run_parity "static_mt" "-DSS_USE_STATIC_MEMORY=1 -DSS_MAX_SIGNALS=256 -DSS_MAX_SLOTS=1024 -DSS_ENABLE_THREAD_SAFETY=1"
+
+echo "Generating parity report..."
+: > "$REPORT"
+differences=0
+for config in dynamic_mt dynamic_st static_mt; do
+    # Exact check first: matching sections mean matching code
+    if command -v size >/dev/null 2>&1; then
+        echo "" >> "$REPORT"
+        echo "== $config: library object ==" >> "$REPORT"
+        (cd "$BUILD_DIR/$config" && size c11/ss_lib.o c89/ss_lib.o \
+            single/ss_lib.o) >> "$REPORT"
+    fi
+    for suite in $SUITES; do
+        dir="$BUILD_DIR/$config/$suite"
+        echo "" >> "$REPORT"
+        echo "== $config: benchmark_$suite ==" >> "$REPORT"
+        "$SCRIPT_DIR/compare_results.py" "$dir" >> "$REPORT"
+        # A "REGRESSION" here means slower than the C11 implementation
+        for variant in c89 single; do
+            if ! "$SCRIPT_DIR/compare_results.py" "$dir/c11.json" \
+                "$dir/$variant.json" >> "$REPORT"; then
+                differences=1
+            fi
+        done
+    done
+done
+cat "$REPORT"
+
+if [ "$differences" -ne 0 ]; then
+    echo ""
+    echo "Some implementations are slower than c11 beyond noise"
+fi
+echo "Parity complete! Results saved to: $BUILD_DIR"
@@ -167,8 +167,41 @@ def plot_benchmarks(results, output_dir="plots"):
     plt.savefig(os.path.join(output_dir, 'operations_performance.png'), dpi=150)
     plt.close()
     
+    plot_registry_scaling(results, output_dir)
+
     print(f"Plots saved to {output_dir}/")
 
+def plot_registry_scaling(results, output_dir):
+    """Plot per-operation cost against registry size (benchmark_scaling)"""
+    for config, benches in results.items():
+        series = defaultdict(list)
+        for name, values in benches.items():
+            match = re.match(r'Registry (.+) \(n=(\d+)\)$', name)
+            if match:
+                series[match.group(1)].append((int(match.group(2)), values['avg']))
+
+        if not series:
+            continue
+
+        fig, ax = plt.subplots(figsize=(10, 6))
+        for op, points in sorted(series.items()):
+            points.sort()
+            ax.plot([p[0] for p in points], [p[1] for p in points],
+                    marker='o', label=op)
+
+        ax.set_xscale('log')
+        ax.set_yscale('log')
+        ax.set_xlabel('Registered signals')
+        ax.set_ylabel('Average Time per Operation (ns)')
+        ax.set_title(f'Registry Size Scaling ({config})')
+        ax.legend()
+        ax.grid(True, which='both', alpha=0.3)
+
+        plt.tight_layout()
+        suffix = '' if config == 'default' else '_' + re.sub(r'\W+', '_', config)
+        plt.savefig(os.path.join(output_dir, f'registry_scaling{suffix}.png'), dpi=150)
+        plt.close()
+
 def generate_json_report(results, output_file="benchmark_results.json"):
     """Generate JSON report for further processing"""
     with open(output_file, 'w') as f:
@@ -6,10 +6,11 @@
 set -e
 
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
-OUTPUT_FILE="$SCRIPT_DIR/ss_lib_single.h"
+OUTPUT_FILE="${1:-$SCRIPT_DIR/ss_lib_single.h}"
 HEADER_FILE="$SCRIPT_DIR/include/ss_lib.h"
 CONFIG_FILE="$SCRIPT_DIR/include/ss_config.h"
 SOURCE_FILE="$SCRIPT_DIR/src/ss_lib.c"
+USDT_FILE="$SCRIPT_DIR/src/ss_usdt.h"
 
 # Check if required files exist
 if [ ! -f "$HEADER_FILE" ]; then
@@ -27,6 +28,11 @@ if [ ! -f "$SOURCE_FILE" ]; then
     exit 1
 fi
 
+if [ ! -f "$USDT_FILE" ]; then
+    echo "Error: Probe header not found: $USDT_FILE"
+    exit 1
+fi
+
 echo "Creating single header file: $OUTPUT_FILE"
 
 # Start with header guard
@@ -39,7 +45,10 @@ cat > "$OUTPUT_FILE" << 'EOF'
  * Usage:
  *   #define SS_IMPLEMENTATION
  *   #include "ss_lib_single.h"
- * 
+ *
+ * In the implementation file, include this before any system header so
+ * the POSIX feature macros below take effect.
+ *
  * Configuration:
  *   Define configuration macros before including this file.
  *   See ss_config.h section for available options.
@@ -48,6 +57,18 @@ cat > "$OUTPUT_FILE" << 'EOF'
 #ifndef SS_LIB_SINGLE_H
 #define SS_LIB_SINGLE_H
 
+/* The implementation uses strdup, clock_gettime and recursive mutexes,
+ * which strict ISO modes (-std=c11) hide. These must precede every system
+ * include, so they cannot wait for the implementation section. */
+#if defined(SS_IMPLEMENTATION) && !defined(_WIN32)
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#endif
+
 EOF
 
 # Add config file content (without guards)
@@ -81,8 +102,21 @@ cat >> "$OUTPUT_FILE" << 'EOF'
 EOF
 
 # Add source file content, stripping only project-local includes
-# System includes remain in place with their #ifdef guards
-sed '/#include "ss_lib.h"/d; /#include "ss_config.h"/d' "$SOURCE_FILE" >> "$OUTPUT_FILE"
+# System includes remain in place with their #ifdef guards.
+# The private probe header is inlined where the source includes it.
+USDT_TMP="${OUTPUT_FILE}.usdt"
+sed -n '/^#ifndef SS_USDT_H/,/^#endif.*SS_USDT_H/{
+/^#ifndef SS_USDT_H/d
+/^#define SS_USDT_H/d
+/^#endif.*SS_USDT_H/d
+p
+}' "$USDT_FILE" | grep -v '#include "ss_config.h"' > "$USDT_TMP"
+sed -e '/#include "ss_lib.h"/d' -e '/#include "ss_config.h"/d' \
+    -e "/#include \"ss_usdt.h\"/{
+r $USDT_TMP
+d
+}" "$SOURCE_FILE" >> "$OUTPUT_FILE"
+rm -f "$USDT_TMP"
 
 # Close implementation guard
 echo "" >> "$OUTPUT_FILE"
@@ -6,6 +6,13 @@
  * ======================================================================== */
 
 /* Memory Configuration */
+
+/* Embedded builds use static pools; decided here so the sizes below apply */
+#ifdef SS_EMBEDDED_BUILD
+    #undef SS_USE_STATIC_MEMORY
+    #define SS_USE_STATIC_MEMORY 1
+#endif
+
 #ifndef SS_USE_STATIC_MEMORY
     #define SS_USE_STATIC_MEMORY 0
 #endif
@@ -53,6 +60,60 @@
     #define SS_ENABLE_DEBUG_TRACE 0
 #endif
 
+#ifndef SS_ENABLE_TRACE_BUFFER
+    #define SS_ENABLE_TRACE_BUFFER 0
+#endif
+
+#ifndef SS_ENABLE_QUEUE_STATS
+    #define SS_ENABLE_QUEUE_STATS 0
+#endif
+
+/* Pre/post emission and slot hooks for external tracers */
+#ifndef SS_ENABLE_HOOKS
+    #define SS_ENABLE_HOOKS 0
+#endif
+
+/* Top-K hot-signal tracking by emission count and slot time */
+#ifndef SS_ENABLE_HOT_SIGNALS
+    #define SS_ENABLE_HOT_SIGNALS 0
+#endif
+
+/* Per-signal wasted-emission and fan-out counters */
+#ifndef SS_ENABLE_WASTE_STATS
+    #define SS_ENABLE_WASTE_STATS 0
+#endif
+
+/* Parent-to-child emission edges with counts and times */
+#ifndef SS_ENABLE_CALL_GRAPH
+    #define SS_ENABLE_CALL_GRAPH 0
+#endif
+
+/* Per-thread emission counters */
+#ifndef SS_ENABLE_THREAD_STATS
+    #define SS_ENABLE_THREAD_STATS 0
+#endif
+
+/* USDT probes for bpftrace/perf; default on where <sys/sdt.h> exists */
+#ifndef SS_ENABLE_USDT
+    #if defined(__linux__) && defined(__has_include)
+        #if __has_include(<sys/sdt.h>)
+            #define SS_ENABLE_USDT 1
+        #endif
+    #endif
+    #ifndef SS_ENABLE_USDT
+        #define SS_ENABLE_USDT 0
+    #endif
+#endif
+
+/* Power-of-two size-class histogram of allocations (needs memory stats) */
+#ifndef SS_ENABLE_ALLOC_HISTOGRAM
+    #define SS_ENABLE_ALLOC_HISTOGRAM 0
+#endif
+
+#ifndef SS_ALLOC_SIZE_CLASSES
+    #define SS_ALLOC_SIZE_CLASSES 16
+#endif
+
 /* Platform Configuration */
 #ifndef SS_ENABLE_ISR_SAFE
     #define SS_ENABLE_ISR_SAFE 0
@@ -62,6 +123,20 @@
     #define SS_ISR_QUEUE_SIZE 16
 #endif
 
+/* Read the x86-64 time-stamp counter for profiling timestamps */
+#ifndef SS_ENABLE_TSC_CLOCK
+    #if defined(__x86_64__) && defined(__linux__) && \
+        (defined(__GNUC__) || defined(__clang__))
+        #define SS_ENABLE_TSC_CLOCK 1
+    #else
+        #define SS_ENABLE_TSC_CLOCK 0
+    #endif
+#endif
+
+#ifndef SS_TSC_CALIBRATION_NS
+    #define SS_TSC_CALIBRATION_NS 2000000
+#endif
+
 #ifndef SS_CACHE_LINE_SIZE
     #define SS_CACHE_LINE_SIZE 64
 #endif
@@ -75,6 +150,54 @@
     #define SS_DEFERRED_QUEUE_SIZE 64
 #endif
 
+/* Latency histograms: 2^SUB_BUCKET_BITS linear sub-buckets per power of
+ * two, covering values below 2^MAX_BITS ns. Memory per histogram is
+ * (MAX_BITS - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS 64-bit counters. */
+#ifndef SS_PERF_HISTOGRAM_SUB_BUCKET_BITS
+    #define SS_PERF_HISTOGRAM_SUB_BUCKET_BITS 3
+#endif
+
+#ifndef SS_PERF_HISTOGRAM_MAX_BITS
+    #define SS_PERF_HISTOGRAM_MAX_BITS 36
+#endif
+
+/* Hot-signal counters per metric (top-K is reliable for K well below
+ * this), and how often tracked weights are halved to age out old load */
+#ifndef SS_HOT_SIGNALS_CAPACITY
+    #define SS_HOT_SIGNALS_CAPACITY 32
+#endif
+
+#ifndef SS_HOT_SIGNALS_DECAY_NS
+    #define SS_HOT_SIGNALS_DECAY_NS 1000000000ULL
+#endif
+
+/* Call graph: edge table size (power of two) and tracked nesting depth */
+#ifndef SS_CALL_GRAPH_MAX_EDGES
+    #define SS_CALL_GRAPH_MAX_EDGES 256
+#endif
+
+#ifndef SS_CALL_GRAPH_MAX_DEPTH
+    #define SS_CALL_GRAPH_MAX_DEPTH 16
+#endif
+
+/* Thread stats: pool size (the last block is shared by any extra threads) */
+#ifndef SS_MAX_THREAD_STATS
+    #define SS_MAX_THREAD_STATS 16
+#endif
+
+#ifndef SS_THREAD_NAME_LENGTH
+    #define SS_THREAD_NAME_LENGTH 16
+#endif
+
+/* Trace buffer (record count must be a power of two) */
+#ifndef SS_TRACE_BUFFER_SIZE
+    #define SS_TRACE_BUFFER_SIZE 4096
+#endif
+
+#ifndef SS_TRACE_NAME_LENGTH
+    #define SS_TRACE_NAME_LENGTH 32
+#endif
+
 /* Custom Memory Functions */
 #ifndef SS_MALLOC
     #define SS_MALLOC(size) malloc(size)
@@ -126,13 +249,34 @@
     
     #undef SS_ENABLE_MEMORY_STATS
     #define SS_ENABLE_MEMORY_STATS 0
+
+    #undef SS_ENABLE_TRACE_BUFFER
+    #define SS_ENABLE_TRACE_BUFFER 0
+
+    #undef SS_ENABLE_QUEUE_STATS
+    #define SS_ENABLE_QUEUE_STATS 0
+
+    #undef SS_ENABLE_HOOKS
+    #define SS_ENABLE_HOOKS 0
+
+    #undef SS_ENABLE_USDT
+    #define SS_ENABLE_USDT 0
+
+    #undef SS_ENABLE_HOT_SIGNALS
+    #define SS_ENABLE_HOT_SIGNALS 0
+
+    #undef SS_ENABLE_WASTE_STATS
+    #define SS_ENABLE_WASTE_STATS 0
+
+    #undef SS_ENABLE_CALL_GRAPH
+    #define SS_ENABLE_CALL_GRAPH 0
+
+    #undef SS_ENABLE_THREAD_STATS
+    #define SS_ENABLE_THREAD_STATS 0
 #endif
 
 /* Embedded Build */
 #ifdef SS_EMBEDDED_BUILD
-    #undef SS_USE_STATIC_MEMORY
-    #define SS_USE_STATIC_MEMORY 1
-    
     #undef SS_ENABLE_THREAD_SAFETY
     #define SS_ENABLE_THREAD_SAFETY 0
     
@@ -140,4 +284,13 @@
     #define SS_DEFAULT_MAX_SLOTS_PER_SIGNAL 10
 #endif
 
+/* Timing source shared by profiling and tracing features */
+#define SS_NEED_CLOCK (SS_ENABLE_PERFORMANCE_STATS || SS_ENABLE_TRACE_BUFFER || \
+                       SS_ENABLE_QUEUE_STATS || SS_ENABLE_HOOKS || \
+                       SS_ENABLE_HOT_SIGNALS || SS_ENABLE_CALL_GRAPH || \
+                       SS_ENABLE_THREAD_STATS)
+
+/* Latency histograms back per-signal and per-queue timings */
+#define SS_NEED_HISTOGRAM (SS_ENABLE_PERFORMANCE_STATS || SS_ENABLE_QUEUE_STATS)
+
 #endif /* SS_CONFIG_H */
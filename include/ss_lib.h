@@ -17,6 +17,10 @@
 #include <stdint.h>
 #include "ss_config.h"
 
+#if SS_ENABLE_TRACE_BUFFER
+#include <stdio.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -35,7 +39,9 @@ typedef enum {
     SS_ERR_MAX_SLOTS,           /**< Maximum slots reached (static mode) */
     SS_ERR_TIMEOUT,             /**< Operation timed out */
     SS_ERR_WOULD_OVERFLOW,      /**< Operation would overflow buffer */
-    SS_ERR_ISR_UNSAFE           /**< Operation not safe in ISR context */
+    SS_ERR_ISR_UNSAFE,          /**< Operation not safe in ISR context */
+    SS_ERR_UNSUPPORTED,         /**< Not supported on this platform/build */
+    SS_ERR_IO                   /**< Writing output failed */
 } ss_error_t;
 
 /**
@@ -289,6 +295,7 @@ ss_error_t ss_emit_pointer(const char* signal_name, void* value);
 #if SS_ENABLE_ISR_SAFE
 /* ISR-safe emission (no locks, no malloc) */
 ss_error_t ss_emit_from_isr(const char* signal_name, int value);
+ss_error_t ss_process_isr_queue(void);
 #endif
 
 /* Deferred emission */
@@ -320,6 +327,15 @@ void* ss_data_get_pointer(const ss_data_t* data);
 void* ss_data_get_custom(const ss_data_t* data, size_t* size);
 #endif
 
+#if SS_ENABLE_INTROSPECTION || SS_ENABLE_CALL_GRAPH
+/* Text export formats */
+typedef enum {
+    SS_FMT_PROMETHEUS = 1,  /* Prometheus text exposition format */
+    SS_FMT_JSON = 2,
+    SS_FMT_DOT = 3          /* Graphviz; call graph only */
+} ss_format_t;
+#endif
+
 #if SS_ENABLE_INTROSPECTION
 /* Signal information */
 typedef struct ss_signal_info {
@@ -332,9 +348,31 @@ typedef struct ss_signal_info {
 size_t ss_get_signal_count(void);
 ss_error_t ss_get_signal_list(ss_signal_info_t** list, size_t* count);
 void ss_free_signal_list(ss_signal_info_t* list, size_t count);
+
+/* Metrics export */
+ss_error_t ss_metrics_write(char* buf, size_t len, ss_format_t format,
+                            size_t* written);
 #endif
 
 #if SS_ENABLE_MEMORY_STATS
+/* Allocation categories */
+typedef enum {
+    SS_ALLOC_SIGNALS,
+    SS_ALLOC_SLOTS,
+    SS_ALLOC_NAMES,         /* Signal names, descriptions, namespace */
+    SS_ALLOC_PAYLOADS,      /* ss_data_t and copied string/custom values */
+    SS_ALLOC_QUEUES,        /* Batches */
+    SS_ALLOC_OTHER,         /* Context, introspection lists */
+    SS_ALLOC_COUNT
+} ss_alloc_category_t;
+
+typedef struct ss_alloc_stats {
+    size_t live_bytes;
+    size_t peak_bytes;
+    size_t live_count;
+    uint64_t total_count;           /* Allocations since the last reset */
+} ss_alloc_stats_t;
+
 /* Memory statistics */
 typedef struct ss_memory_stats {
     size_t signals_allocated;
@@ -344,25 +382,226 @@ typedef struct ss_memory_stats {
     size_t total_bytes_allocated;
     size_t peak_bytes_allocated;
     size_t string_bytes;
+    size_t queue_bytes;             /* Deferred/ISR queues and live batches */
+    ss_alloc_stats_t categories[SS_ALLOC_COUNT];
+    /* [i]: sizes <= 2^i; zero unless built with SS_ENABLE_ALLOC_HISTOGRAM */
+    uint64_t size_classes[SS_ALLOC_SIZE_CLASSES];
 } ss_memory_stats_t;
 
 ss_error_t ss_get_memory_stats(ss_memory_stats_t* stats);
 void ss_reset_memory_stats(void);
 #endif
 
-#if SS_ENABLE_PERFORMANCE_STATS
-/* Performance statistics */
+#if SS_NEED_HISTOGRAM
+/* Log-linear (HDR-style) latency histogram with fixed memory */
+#define SS_PERF_HISTOGRAM_BUCKETS \
+    ((SS_PERF_HISTOGRAM_MAX_BITS - SS_PERF_HISTOGRAM_SUB_BUCKET_BITS + 1) \
+     << SS_PERF_HISTOGRAM_SUB_BUCKET_BITS)
+
+typedef struct ss_histogram {
+    uint64_t counts[SS_PERF_HISTOGRAM_BUCKETS];
+    uint64_t total_count;
+    uint64_t max_value;
+} ss_histogram_t;
+
+void ss_histogram_reset(ss_histogram_t* hist);
+void ss_histogram_record(ss_histogram_t* hist, uint64_t value_ns);
+void ss_histogram_merge(ss_histogram_t* dst, const ss_histogram_t* src);
+uint64_t ss_histogram_percentile(const ss_histogram_t* hist, double percentile);
+#endif
+
+/* Performance statistics; always declared so structs embedding it keep
+ * one layout whatever the caller's SS_ENABLE_PERFORMANCE_STATS */
 typedef struct ss_perf_stats {
-    uint64_t total_emissions;
-    uint64_t total_time_ns;
-    uint64_t avg_time_ns;
+    uint64_t total_emissions;       /* Exact, counted on every emission */
+    uint64_t total_time_ns;         /* Estimated: sampled time scaled up */
+    uint64_t avg_time_ns;           /* Over sampled emissions */
     uint64_t max_time_ns;
     uint64_t min_time_ns;
+    uint64_t sampled_emissions;     /* Emissions that were timed */
+    uint64_t sampled_time_ns;       /* Measured time of timed emissions */
 } ss_perf_stats_t;
 
+#if SS_ENABLE_PERFORMANCE_STATS
 ss_error_t ss_get_perf_stats(const char* signal_name, ss_perf_stats_t* stats);
 ss_error_t ss_enable_profiling(int enabled);
+ss_error_t ss_set_profiling_sample_rate(const char* signal_name,
+                                        uint32_t one_in_n);
 void ss_reset_perf_stats(void);
+
+ss_error_t ss_get_perf_histogram(const char* signal_name, ss_histogram_t* hist);
+ss_error_t ss_get_perf_percentiles(const char* signal_name,
+                                   const double* percentiles, size_t count,
+                                   uint64_t* out);
+#endif
+
+#if SS_ENABLE_INTROSPECTION
+/* Allocation-free iteration; views borrow from the registry */
+typedef struct ss_signal_view {
+    const char* name;
+    const char* description;   /* NULL in cursor views */
+    uint32_t id;
+    size_t slot_count;
+    ss_priority_t priority;
+    ss_perf_stats_t perf_stats; /* Zero without SS_ENABLE_PERFORMANCE_STATS */
+} ss_signal_view_t;
+
+typedef struct ss_slot_view {
+    ss_connection_t handle;
+    ss_slot_func_t func;
+    void* user_data;
+    ss_priority_t priority;
+} ss_slot_view_t;
+
+/* Return non-zero to stop the walk */
+typedef int (*ss_signal_visit_func_t)(const ss_signal_view_t* view, void* ctx);
+typedef int (*ss_slot_visit_func_t)(const ss_slot_view_t* view, void* ctx);
+
+ss_error_t ss_foreach_signal(ss_signal_visit_func_t visit, void* ctx);
+ss_error_t ss_foreach_slot(const char* signal_name, ss_slot_visit_func_t visit,
+                           void* ctx);
+
+/* Resumable cursor; the library is unlocked between calls */
+typedef struct ss_signal_iter {
+    const void* pos;           /* Internal: last signal returned */
+    uint32_t last_id;
+    uint32_t generation;
+    char name[SS_MAX_SIGNAL_NAME_LENGTH];
+} ss_signal_iter_t;
+
+void ss_signal_iter_init(ss_signal_iter_t* it);
+ss_error_t ss_signal_iter_next(ss_signal_iter_t* it, ss_signal_view_t* view);
+#endif
+
+#if SS_ENABLE_QUEUE_STATS
+/* Internal queues */
+typedef enum {
+    SS_QUEUE_DEFERRED,      /* ss_emit_deferred / ss_flush_deferred */
+    SS_QUEUE_ISR,           /* ss_emit_from_isr / ss_process_isr_queue */
+    SS_QUEUE_BATCH,         /* All batches, aggregated */
+    SS_QUEUE_COUNT
+} ss_queue_id_t;
+
+/* Queue telemetry */
+typedef struct ss_queue_stats {
+    size_t capacity;                /* Entries per queue (per batch) */
+    size_t depth;                   /* Entries waiting now */
+    size_t high_water;              /* Deepest a single queue has been */
+    uint64_t enqueued;
+    uint64_t dropped;               /* Rejected with SS_ERR_WOULD_OVERFLOW */
+    uint64_t flushes;               /* Flushes that dispatched entries */
+    uint64_t flushed;               /* Entries dispatched by flushes */
+    uint64_t flush_time_ns;
+    ss_histogram_t flush_histogram; /* Flush durations in ns */
+} ss_queue_stats_t;
+
+ss_error_t ss_get_queue_stats(ss_queue_id_t queue, ss_queue_stats_t* stats);
+void ss_reset_queue_stats(void);
+#endif
+
+#if SS_ENABLE_HOT_SIGNALS
+/* Heavy-hitter signals */
+typedef enum {
+    SS_HOT_BY_EMISSIONS,
+    SS_HOT_BY_TIME                  /* Time spent in slots */
+} ss_hot_metric_t;
+
+typedef struct ss_hot_signal {
+    char name[SS_MAX_SIGNAL_NAME_LENGTH];
+    uint32_t signal_id;
+    uint64_t emissions;             /* Decayed estimate, 0 if not tracked */
+    uint64_t emissions_error;       /* Maximum overcount of emissions */
+    uint64_t time_ns;               /* Decayed estimate, 0 if not tracked */
+    uint64_t time_error_ns;         /* Maximum overcount of time_ns */
+} ss_hot_signal_t;
+
+ss_error_t ss_enable_hot_signals(int enabled);
+ss_error_t ss_get_hot_signals(ss_hot_metric_t metric, size_t k,
+                              ss_hot_signal_t* out, size_t* count);
+void ss_reset_hot_signals(void);
+#endif
+
+#if SS_ENABLE_WASTE_STATS
+/* Fan-out buckets: [0] no slot ran, [i] 2^(i-1) to 2^i - 1 slots,
+ * the last bucket also counts anything larger */
+#define SS_FANOUT_BUCKETS 8
+
+typedef struct ss_waste_stats {
+    char name[SS_MAX_SIGNAL_NAME_LENGTH];
+    uint64_t emissions;
+    uint64_t zero_slot_emissions;   /* No slot connected */
+    uint64_t all_removed_emissions; /* Slots connected, all pending removal */
+    uint64_t wasted_emissions;      /* Sum of the two above */
+    uint64_t slot_calls;
+    uint64_t fanout[SS_FANOUT_BUCKETS];
+} ss_waste_stats_t;
+
+ss_error_t ss_get_waste_stats(const char* signal_name, ss_waste_stats_t* stats);
+ss_error_t ss_get_waste_report(ss_waste_stats_t* out, size_t max, size_t* count);
+uint64_t ss_get_not_found_emissions(char* last_name, size_t len);
+void ss_reset_waste_stats(void);
+#endif
+
+#if SS_ENABLE_CALL_GRAPH
+/* Emission call graph */
+ss_error_t ss_enable_call_graph(int enabled);
+ss_error_t ss_call_graph_write(char* buf, size_t len, ss_format_t format,
+                               size_t* written);
+void ss_reset_call_graph(void);
+#endif
+
+#if SS_ENABLE_THREAD_STATS
+/* Per-thread emission statistics */
+typedef struct ss_thread_stats {
+    char name[SS_THREAD_NAME_LENGTH];   /* Empty unless ss_set_thread_name */
+    uint32_t thread_id;                 /* Same ids as the trace buffer */
+    uint64_t emissions;
+    uint64_t slot_calls;
+    uint64_t dispatch_time_ns;          /* Includes nested emissions */
+    uint64_t deferred_enqueues;
+    uint64_t lock_waits;                /* Contended lock acquisitions */
+    uint64_t lock_wait_ns;
+} ss_thread_stats_t;
+
+ss_error_t ss_enable_thread_stats(int enabled);
+ss_error_t ss_set_thread_name(const char* name);
+ss_error_t ss_get_thread_stats(ss_thread_stats_t* out, size_t max, size_t* count);
+void ss_reset_thread_stats(void);
+#endif
+
+#if SS_NEED_CLOCK
+/* Timing source for profiling and tracing */
+typedef enum {
+    SS_CLOCK_DEFAULT,           /* TSC when usable, else monotonic */
+    SS_CLOCK_MONOTONIC,         /* clock_gettime / QueryPerformanceCounter */
+    SS_CLOCK_TSC                /* Calibrated x86-64 time-stamp counter */
+} ss_clock_source_t;
+
+typedef uint64_t (*ss_clock_func_t)(void* user_data);
+
+ss_error_t ss_set_clock_source(ss_clock_source_t source);
+ss_error_t ss_set_clock(ss_clock_func_t func, void* user_data);
+uint64_t ss_clock_now_ns(void);
+#endif
+
+#if SS_ENABLE_HOOKS
+/* Emission hooks for external tracers */
+typedef struct ss_hook_info {
+    uint32_t signal_id;             /* Unique per registration, never 0 */
+    const char* signal_name;
+    const ss_data_t* data;
+    ss_slot_func_t slot;            /* Slot hooks only, else NULL */
+    void* slot_user_data;           /* Slot hooks only, else NULL */
+    size_t slot_count;              /* Slots connected at emission */
+    uint64_t timestamp_ns;          /* ss_clock_now_ns() when the hook fires */
+    uint64_t elapsed_ns;            /* Post hooks: duration of the emission
+                                       or slot call; 0 in pre hooks */
+} ss_hook_info_t;
+
+typedef void (*ss_hook_func_t)(const ss_hook_info_t* info, void* ctx);
+
+ss_error_t ss_set_emit_hooks(ss_hook_func_t pre, ss_hook_func_t post, void* ctx);
+ss_error_t ss_set_slot_hooks(ss_hook_func_t pre, ss_hook_func_t post, void* ctx);
 #endif
 
 /* Error handling */
@@ -399,6 +638,14 @@ void ss_enable_trace(FILE* output);
 void ss_disable_trace(void);
 #endif
 
+#if SS_ENABLE_TRACE_BUFFER
+/* Binary trace buffer with Chrome Trace Event export */
+ss_error_t ss_trace_buffer_start(void);
+void ss_trace_buffer_stop(void);
+void ss_trace_buffer_clear(void);
+ss_error_t ss_trace_export_chrome(FILE* output);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
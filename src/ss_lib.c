@@ -4,31 +4,108 @@
 #endif
 
 #include "ss_lib.h"
+#include "ss_usdt.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdarg.h>
 #include <time.h>
 
+#if SS_NEED_CLOCK && SS_ENABLE_TSC_CLOCK
+#include <cpuid.h>
+#endif
+
 #if SS_ENABLE_THREAD_SAFETY
 #ifdef _WIN32
 #include <windows.h>
 typedef CRITICAL_SECTION ss_mutex_t;
 #define SS_MUTEX_INIT(m) InitializeCriticalSection(m)
-#define SS_MUTEX_LOCK(m) EnterCriticalSection(m)
+#define SS_MUTEX_ACQUIRE(m) EnterCriticalSection(m)
+#define SS_MUTEX_TRYLOCK(m) (TryEnterCriticalSection(m) != 0)
 #define SS_MUTEX_UNLOCK(m) LeaveCriticalSection(m)
 #define SS_MUTEX_DESTROY(m) DeleteCriticalSection(m)
 #else
 #include <pthread.h>
 typedef pthread_mutex_t ss_mutex_t;
-#define SS_MUTEX_INIT(m) pthread_mutex_init(m, NULL)
-#define SS_MUTEX_LOCK(m) pthread_mutex_lock(m)
+#define SS_MUTEX_INIT(m) ss_mutex_init_recursive(m)
+#define SS_MUTEX_ACQUIRE(m) pthread_mutex_lock(m)
+#define SS_MUTEX_TRYLOCK(m) (pthread_mutex_trylock(m) == 0)
 #define SS_MUTEX_UNLOCK(m) pthread_mutex_unlock(m)
 #define SS_MUTEX_DESTROY(m) pthread_mutex_destroy(m)
 #endif
 
+#ifndef _WIN32
+/* Recursive like a critical section, so slots may emit other signals */
+static void ss_mutex_init_recursive(ss_mutex_t* m) {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(m, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+#endif
+
+#if SS_ENABLE_USDT || SS_ENABLE_THREAD_STATS
+/* Contended acquisitions are timed; see mutex_lock_probed() */
+static void mutex_lock_probed(ss_mutex_t* m);
+#define SS_MUTEX_LOCK(m) mutex_lock_probed(m)
+#else
+#define SS_MUTEX_LOCK(m) SS_MUTEX_ACQUIRE(m)
+#endif
+
+#endif
+
+/* Relaxed atomic counters for instrumentation shared between threads */
+#if defined(__GNUC__) || defined(__clang__)
+#define SS_ATOMIC_FETCH_ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define SS_ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define SS_ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define SS_ATOMIC_CAS(p, expected, desired) \
+    __atomic_compare_exchange_n((p), (expected), (desired), 1, \
+                                __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#else
+#define SS_ATOMIC_FETCH_ADD(p, v) ((*(p) += (v)) - (v))
+#define SS_ATOMIC_LOAD(p) (*(p))
+#define SS_ATOMIC_STORE(p, v) ((void)(*(p) = (v)))
+#define SS_ATOMIC_CAS(p, expected, desired) \
+    (*(p) == *(expected) ? (*(p) = (desired), 1) : (*(expected) = *(p), 0))
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SS_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define SS_ALWAYS_INLINE
+#endif
+
+/* Thread-local storage for per-thread instrumentation state */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define SS_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define SS_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define SS_THREAD_LOCAL __declspec(thread)
+#else
+#define SS_THREAD_LOCAL
+#endif
+
+#if SS_ENABLE_QUEUE_STATS || SS_ENABLE_MEMORY_STATS
+/* Raise *p to at least v; several producers may race */
+static void atomic_store_max(size_t* p, size_t v) {
+    size_t cur = SS_ATOMIC_LOAD(p);
+    while (cur < v && !SS_ATOMIC_CAS(p, &cur, v)) {
+    }
+}
 #endif
 
 
+/* Runtime-switchable features that observe emissions */
+#define SS_EMIT_INSTRUMENTATION (SS_ENABLE_PERFORMANCE_STATS || SS_ENABLE_HOT_SIGNALS || \
+                                 SS_ENABLE_CALL_GRAPH || SS_ENABLE_THREAD_STATS || \
+                                 SS_ENABLE_HOOKS || SS_ENABLE_TRACE_BUFFER)
+
+/* Emit variant chosen by select_emit_path() */
+typedef ss_error_t (*ss_emit_func_t)(const char* signal_name, const ss_data_t* data);
+
 /* Internal structures */
 typedef struct ss_slot {
     ss_slot_func_t func;
@@ -39,15 +116,34 @@ typedef struct ss_slot {
     int removed;           /* Deferred removal flag for safe emit iteration */
 } ss_slot_t;
 
+#if SS_ENABLE_WASTE_STATS
+typedef struct {
+    uint64_t emissions;
+    uint64_t zero_slot;
+    uint64_t all_removed;
+    uint64_t slot_calls;
+    uint64_t fanout[SS_FANOUT_BUCKETS];
+} ss_waste_counters_t;
+#endif
+
 typedef struct ss_signal {
     char* name;
     char* description;
+    uint32_t id;           /* Unique per registration, never 0 */
+#if SS_ENABLE_HOT_SIGNALS
+    uint16_t hot_hint[2];  /* Last hot-table index per metric, verified by id */
+#endif
+#if SS_ENABLE_WASTE_STATS
+    ss_waste_counters_t waste;
+#endif
     ss_slot_t* slots;
     size_t slot_count;
     ss_priority_t priority;
     int emitting;          /* Non-zero while slots are being invoked */
 #if SS_ENABLE_PERFORMANCE_STATS
-    ss_perf_stats_t perf_stats;
+    ss_perf_stats_t perf_stats;      /* Raw counters; derived fields on read */
+    ss_histogram_t latency_histogram;
+    uint32_t sample_threshold;       /* 0 = use the context default */
 #endif
 
 #if !SS_USE_STATIC_MEMORY
@@ -60,8 +156,94 @@ typedef struct {
     char signal_name[SS_MAX_SIGNAL_NAME_LENGTH];
     ss_data_t data;
     int has_string;  /* Non-zero if data.value.s_val was duplicated */
+#if SS_ENABLE_TRACE_BUFFER
+    uint64_t flow_id;  /* Links enqueue and dispatch in exported traces */
+#endif
 } ss_deferred_entry_t;
 
+#ifndef SS_BATCH_MAX_ENTRIES
+#define SS_BATCH_MAX_ENTRIES SS_DEFERRED_QUEUE_SIZE
+#endif
+
+struct ss_batch {
+    ss_deferred_entry_t entries[SS_BATCH_MAX_ENTRIES];
+    size_t count;
+};
+
+#if SS_ENABLE_ISR_SAFE
+/* ISR-safe emission - minimal overhead, no locks */
+static volatile struct {
+    char signal_name[SS_MAX_SIGNAL_NAME_LENGTH];
+    int value;
+    volatile int pending;
+} g_isr_queue[SS_ISR_QUEUE_SIZE];
+
+#if SS_ENABLE_QUEUE_STATS
+/*
+ * Each counter has a single writer, so neither side needs a lock or an
+ * atomic read-modify-write. 32 bits keeps stores single-copy atomic on
+ * small MCUs; depth is computed with wrapping subtraction.
+ */
+static volatile struct {
+    uint32_t enqueued;      /* Written by the ISR */
+    uint32_t dropped;       /* Written by the ISR */
+    uint32_t high_water;    /* Written by the ISR, rebased by resets */
+    uint32_t drained;       /* Written by ss_process_isr_queue */
+    uint32_t enqueued_base; /* Written by ss_reset_queue_stats */
+    uint32_t dropped_base;  /* Written by ss_reset_queue_stats */
+} g_isr_stats;
+#endif
+#endif
+
+#if SS_ENABLE_TRACE_BUFFER
+typedef enum {
+    SS_TREC_EMIT_BEGIN,
+    SS_TREC_EMIT_END,
+    SS_TREC_SLOT_BEGIN,
+    SS_TREC_SLOT_END,
+    SS_TREC_DEFER,        /* Deferred enqueue, starts a flow */
+    SS_TREC_DEFER_FLUSH   /* Deferred dispatch, ends a flow */
+} ss_trace_record_type_t;
+
+/* Fixed-size binary record; conversion to text happens at export time */
+typedef struct {
+    uint64_t timestamp_ns;
+    uint64_t flow_id;
+    ss_slot_func_t slot;
+    uint32_t thread_id;
+    uint8_t type;
+    char name[SS_TRACE_NAME_LENGTH];
+} ss_trace_record_t;
+#endif
+
+#if SS_ENABLE_HOT_SIGNALS
+#if SS_HOT_SIGNALS_CAPACITY > 65535
+#error "SS_HOT_SIGNALS_CAPACITY must fit the 16-bit per-signal hint"
+#endif
+
+/* Space-Saving counter; signal_id 0 marks an unused entry */
+typedef struct {
+    uint32_t signal_id;
+    uint64_t weight;
+    uint64_t error;        /* Weight inherited from the evicted entry */
+} ss_hot_entry_t;
+#endif
+
+#if SS_ENABLE_CALL_GRAPH
+#if (SS_CALL_GRAPH_MAX_EDGES & (SS_CALL_GRAPH_MAX_EDGES - 1)) != 0
+#error "SS_CALL_GRAPH_MAX_EDGES must be a power of two"
+#endif
+
+/* Hash table entry keyed by (parent, child); child_id 0 marks unused */
+typedef struct {
+    uint32_t parent_id;    /* 0 for top-level emissions */
+    uint32_t child_id;
+    uint64_t count;
+    uint64_t inclusive_ns;
+    uint64_t exclusive_ns; /* Minus time in nested emissions */
+} ss_call_edge_t;
+#endif
+
 typedef struct {
 #if SS_USE_STATIC_MEMORY
     /* Static allocation */
@@ -79,9 +261,13 @@ typedef struct {
 #endif
 
     
+    ss_emit_func_t emit_path;        /* Read on every emission */
     size_t max_slots_per_signal;
     int thread_safe;
     int profiling_enabled;
+#if SS_ENABLE_PERFORMANCE_STATS
+    uint32_t sample_threshold;       /* Time an emission if rng <= this */
+#endif
     char* namespace;
     
 #if SS_ENABLE_THREAD_SAFETY
@@ -96,20 +282,166 @@ typedef struct {
     
     void (*error_handler)(ss_error_t, const char*);
     ss_connection_t next_handle;
+    uint32_t next_signal_id;
+
+#if SS_NEED_CLOCK
+    ss_clock_func_t clock_func;
+    void* clock_user_data;
+#endif
 
-    /* Deferred emission queue */
+    /* Deferred emission queue: ring of deferred_count entries from head */
     ss_deferred_entry_t deferred_queue[SS_DEFERRED_QUEUE_SIZE];
+    size_t deferred_head;
     size_t deferred_count;
+#if SS_ENABLE_QUEUE_STATS
+    ss_queue_stats_t deferred_stats;  /* depth and capacity filled on read */
+#endif
     
 #if SS_ENABLE_DEBUG_TRACE
     FILE* trace_output;
 #endif
 
+#if SS_ENABLE_WASTE_STATS
+    uint64_t not_found_emissions;
+    char last_not_found[SS_MAX_SIGNAL_NAME_LENGTH];
+#endif
+
+#if SS_ENABLE_CALL_GRAPH
+    ss_call_edge_t call_edges[SS_CALL_GRAPH_MAX_EDGES];
+    size_t call_edge_count;
+    uint64_t call_edges_dropped;     /* Emissions whose edge did not fit */
+    uint64_t call_depth_truncated;   /* Emissions nested too deep to track */
+    int call_graph_enabled;
+#endif
+
+#if SS_ENABLE_THREAD_STATS
+    int thread_stats_enabled;
+#endif
+
+#if SS_ENABLE_HOT_SIGNALS
+    ss_hot_entry_t hot_by_count[SS_HOT_SIGNALS_CAPACITY];
+    ss_hot_entry_t hot_by_time[SS_HOT_SIGNALS_CAPACITY];
+    uint64_t hot_window_start;
+    int hot_signals_enabled;
+#endif
+
+#if SS_ENABLE_HOOKS
+    ss_hook_func_t emit_pre_hook;
+    ss_hook_func_t emit_post_hook;
+    void* emit_hook_ctx;
+    ss_hook_func_t slot_pre_hook;
+    ss_hook_func_t slot_post_hook;
+    void* slot_hook_ctx;
+    int hooks_active;         /* Any hook installed; the only emit-path test */
+#endif
+
+#if SS_ENABLE_TRACE_BUFFER
+    ss_trace_record_t trace_records[SS_TRACE_BUFFER_SIZE];
+    uint64_t trace_head;      /* Total records written, wraps via mask */
+    uint64_t next_flow_id;
+    int trace_recording;
+#endif
+
 } ss_context_t;
 
 /* Global context */
 static ss_context_t* g_context = NULL;
 
+static void select_emit_path(void);
+
+#if SS_ENABLE_INTROSPECTION && !SS_USE_STATIC_MEMORY
+/*
+ * Bumped whenever a signal is added or freed, so a cursor can tell whether
+ * its saved position is still valid. Outlives the context, so cursors from
+ * before an ss_cleanup() are never trusted afterwards.
+ */
+static uint32_t g_registry_generation;
+#endif
+
+#if SS_ENABLE_QUEUE_STATS
+/* Batches and the ISR queue outlive the context, so their stats do too */
+static ss_queue_stats_t g_batch_stats;
+#if SS_ENABLE_ISR_SAFE
+static ss_queue_stats_t g_isr_flush_stats;  /* Consumer-side fields only */
+#endif
+#endif
+
+#if SS_ENABLE_MEMORY_STATS
+/*
+ * Allocation accounting. Payloads and batches are allocated without the
+ * context or its lock, so the counters are global relaxed atomics.
+ */
+static struct {
+    ss_alloc_stats_t categories[SS_ALLOC_COUNT];
+    size_t live_bytes;
+    size_t peak_bytes;
+#if SS_ENABLE_ALLOC_HISTOGRAM
+    uint64_t size_classes[SS_ALLOC_SIZE_CLASSES];
+#endif
+} g_alloc;
+
+static void alloc_account(ss_alloc_category_t cat, size_t size) {
+    ss_alloc_stats_t* c = &g_alloc.categories[cat];
+    atomic_store_max(&c->peak_bytes,
+                     SS_ATOMIC_FETCH_ADD(&c->live_bytes, size) + size);
+    SS_ATOMIC_FETCH_ADD(&c->live_count, 1);
+    SS_ATOMIC_FETCH_ADD(&c->total_count, 1);
+    atomic_store_max(&g_alloc.peak_bytes,
+                     SS_ATOMIC_FETCH_ADD(&g_alloc.live_bytes, size) + size);
+#if SS_ENABLE_ALLOC_HISTOGRAM
+    {
+        size_t i = 0;
+        while (i < SS_ALLOC_SIZE_CLASSES - 1 && ((size_t)1 << i) < size) i++;
+        SS_ATOMIC_FETCH_ADD(&g_alloc.size_classes[i], 1);
+    }
+#endif
+}
+
+static void alloc_release(ss_alloc_category_t cat, size_t size) {
+    SS_ATOMIC_FETCH_ADD(&g_alloc.categories[cat].live_bytes, (size_t)0 - size);
+    SS_ATOMIC_FETCH_ADD(&g_alloc.categories[cat].live_count, (size_t)0 - 1);
+    SS_ATOMIC_FETCH_ADD(&g_alloc.live_bytes, (size_t)0 - size);
+}
+
+static void* acct_malloc(ss_alloc_category_t cat, size_t size) {
+    void* ptr = SS_MALLOC(size);
+    if (ptr) alloc_account(cat, size);
+    return ptr;
+}
+
+static void* acct_calloc(ss_alloc_category_t cat, size_t count, size_t size) {
+    void* ptr = SS_CALLOC(count, size);
+    if (ptr) alloc_account(cat, count * size);
+    return ptr;
+}
+
+static char* acct_strdup(ss_alloc_category_t cat, const char* str) {
+    char* copy = SS_STRDUP(str);
+    if (copy) alloc_account(cat, strlen(copy) + 1);
+    return copy;
+}
+
+/* Callers pass the size they allocated; strings use strlen + 1 */
+static void acct_free(ss_alloc_category_t cat, void* ptr, size_t size) {
+    if (!ptr) return;
+    alloc_release(cat, size);
+    SS_FREE(ptr);
+}
+
+#define SS_ACCT_MALLOC(cat, size) acct_malloc((cat), (size))
+#define SS_ACCT_CALLOC(cat, count, size) acct_calloc((cat), (count), (size))
+#define SS_ACCT_STRDUP(cat, str) acct_strdup((cat), (str))
+#define SS_ACCT_FREE(cat, ptr, size) acct_free((cat), (void*)(ptr), (size))
+#define SS_ACCT_FREE_STRING(cat, str) \
+    acct_free((cat), (void*)(str), strlen(str) + 1)
+#else
+#define SS_ACCT_MALLOC(cat, size) SS_MALLOC(size)
+#define SS_ACCT_CALLOC(cat, count, size) SS_CALLOC(count, size)
+#define SS_ACCT_STRDUP(cat, str) SS_STRDUP(str)
+#define SS_ACCT_FREE(cat, ptr, size) SS_FREE((void*)(ptr))
+#define SS_ACCT_FREE_STRING(cat, str) SS_FREE((void*)(str))
+#endif
+
 /* Helper functions */
 
 /*
@@ -130,8 +462,63 @@ static long ss_strscpy(char* dst, const char* src, size_t count) {
     return (long)i;
 }
 
-#if SS_ENABLE_PERFORMANCE_STATS
-static uint64_t get_time_ns(void) {
+#if SS_ENABLE_TRACE_BUFFER || SS_ENABLE_INTROSPECTION || SS_ENABLE_CALL_GRAPH
+/*
+ * Output sink shared by the exporters: either a FILE or a caller buffer.
+ * In buffer mode pos keeps counting past len so the caller learns the
+ * size it needs; the buffer is always null-terminated when len > 0.
+ */
+typedef struct {
+    FILE* file;
+    char* buf;
+    size_t len;
+    size_t pos;
+    int failed;
+} ss_writer_t;
+
+static void writer_printf(ss_writer_t* w, const char* fmt, ...) {
+    va_list ap;
+    int n;
+    va_start(ap, fmt);
+    if (w->file) {
+        n = vfprintf(w->file, fmt, ap);
+    } else {
+        size_t room = w->pos < w->len ? w->len - w->pos : 0;
+        n = vsnprintf(room ? w->buf + w->pos : NULL, room, fmt, ap);
+    }
+    va_end(ap);
+    if (n < 0) {
+        w->failed = 1;
+    } else {
+        w->pos += (size_t)n;
+    }
+}
+
+/*
+ * Quoted string literal. JSON escapes quotes, backslashes and controls;
+ * Prometheus label values only need quotes, backslashes and newlines.
+ */
+static void writer_quoted(ss_writer_t* w, const char* str, int prometheus) {
+    writer_printf(w, "\"");
+    for (; *str; str++) {
+        unsigned char c = (unsigned char)*str;
+        if (c == '"' || c == '\\') {
+            writer_printf(w, "\\%c", c);
+        } else if (c == '\n' && prometheus) {
+            writer_printf(w, "\\n");
+        } else if (c < 0x20 && !prometheus) {
+            writer_printf(w, "\\u%04x", c);
+        } else {
+            writer_printf(w, "%c", c);
+        }
+    }
+    writer_printf(w, "\"");
+}
+#endif
+
+#if SS_NEED_CLOCK || (SS_ENABLE_USDT && SS_ENABLE_THREAD_SAFETY)
+static uint64_t monotonic_clock(void* user_data) {
+    (void)user_data;
 #ifdef _WIN32
     LARGE_INTEGER freq, count;
     QueryPerformanceFrequency(&freq);
@@ -145,130 +532,771 @@ static uint64_t get_time_ns(void) {
 }
 #endif
 
-#if SS_USE_STATIC_MEMORY
-static ss_signal_t* find_signal(const char* name) {
-    size_t i;
-    if (!g_context || !name) return NULL;
-    
-    for (i = 0; i < SS_MAX_SIGNALS; i++) {
-        if (g_context->signal_used[i] && 
-            strcmp(g_context->signals[i].name, name) == 0) {
-            return &g_context->signals[i];
-        }
+#if SS_ENABLE_TRACE_BUFFER || SS_ENABLE_THREAD_STATS
+static uint32_t g_next_thread_id = 0;
+static SS_THREAD_LOCAL uint32_t t_thread_id = 0;
+
+/* Small sequential per-thread id, assigned on first use */
+static uint32_t current_thread_id(void) {
+    if (t_thread_id == 0) {
+        t_thread_id = SS_ATOMIC_FETCH_ADD(&g_next_thread_id, 1) + 1;
     }
-    return NULL;
+    return t_thread_id;
 }
+#endif
 
-static ss_slot_t* allocate_slot(void) {
-    size_t i;
-    for (i = 0; i < SS_MAX_SLOTS; i++) {
-        if (!g_context->slot_used[i]) {
-            g_context->slot_used[i] = 1;
-            g_context->slot_count++;
-#if SS_ENABLE_MEMORY_STATS
-            {
-                size_t peak = g_context->slot_count * sizeof(ss_slot_t);
-                if (peak > g_context->memory_stats.peak_bytes_allocated) {
-                    g_context->memory_stats.peak_bytes_allocated = peak;
-                }
-            }
+#if SS_ENABLE_THREAD_STATS
+#if SS_MAX_THREAD_STATS < 2
+#error "SS_MAX_THREAD_STATS must leave room for the shared overflow block"
 #endif
 
-            return &g_context->slots[i];
-        }
+/*
+ * Each thread claims a free block on first use and is its only writer, so
+ * counters are relaxed load/store pairs rather than read-modify-writes.
+ * Threads beyond the pool share the last block, which is updated with
+ * atomic adds. A block goes back to the pool when its thread exits and is
+ * cleared when the next thread claims it; until then the exited thread's
+ * totals stay visible. Resets bump an epoch instead of writing counters
+ * other threads own: an owner zeroes its block when it sees a new epoch,
+ * and readers report a block from an older epoch as zero. Blocks fill
+ * whole cache lines so neighbouring threads never write the same line.
+ * The pool outlives the context because thread-local pointers into it do.
+ */
+enum {
+    SS_TBLOCK_UNUSED,
+    SS_TBLOCK_OWNED,
+    SS_TBLOCK_RELEASED       /* Thread exited; counters kept until reuse */
+};
+
+typedef union {
+    struct {
+        ss_thread_stats_t stats;
+        uint32_t epoch;      /* Reset generation the counters belong to */
+        int state;
+        int shared;
+    } b;
+    char pad[((sizeof(ss_thread_stats_t) + sizeof(uint32_t) + 2 * sizeof(int)) /
+              SS_CACHE_LINE_SIZE + 1) * SS_CACHE_LINE_SIZE];
+} ss_thread_block_t;
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((aligned(SS_CACHE_LINE_SIZE)))
+#endif
+static ss_thread_block_t g_thread_blocks[SS_MAX_THREAD_STATS];
+static uint32_t g_thread_blocks_used = 0;   /* Blocks ever claimed */
+static uint32_t g_thread_stats_epoch = 0;
+static SS_THREAD_LOCAL ss_thread_block_t* t_thread_block = NULL;
+
+static void thread_block_zero(ss_thread_block_t* blk) {
+    ss_thread_stats_t* st = &blk->b.stats;
+    SS_ATOMIC_STORE(&st->emissions, 0);
+    SS_ATOMIC_STORE(&st->slot_calls, 0);
+    SS_ATOMIC_STORE(&st->dispatch_time_ns, 0);
+    SS_ATOMIC_STORE(&st->deferred_enqueues, 0);
+    SS_ATOMIC_STORE(&st->lock_waits, 0);
+    SS_ATOMIC_STORE(&st->lock_wait_ns, 0);
+}
+
+#if SS_ENABLE_THREAD_SAFETY
+/* Return the exiting thread's block to the pool */
+#ifdef _WIN32
+static DWORD g_thread_block_key = FLS_OUT_OF_INDEXES;
+static INIT_ONCE g_thread_block_once = INIT_ONCE_STATIC_INIT;
+
+static VOID WINAPI thread_block_release(PVOID blk) {
+    if (blk) {
+        SS_ATOMIC_STORE(&((ss_thread_block_t*)blk)->b.state, SS_TBLOCK_RELEASED);
+        t_thread_block = NULL;
     }
-    return NULL;
 }
 
-static void free_slot(ss_slot_t* slot) {
-    size_t index = slot - g_context->slots;
-    if (index < SS_MAX_SLOTS) {
-        g_context->slot_used[index] = 0;
-        g_context->slot_count--;
-        memset(slot, 0, sizeof(ss_slot_t));
+static BOOL CALLBACK thread_block_key_create(PINIT_ONCE once, PVOID param,
+                                             PVOID* ctx) {
+    (void)once;
+    (void)param;
+    (void)ctx;
+    g_thread_block_key = FlsAlloc(thread_block_release);
+    return TRUE;
+}
+
+static void thread_block_register(ss_thread_block_t* blk) {
+    InitOnceExecuteOnce(&g_thread_block_once, thread_block_key_create, NULL,
+                        NULL);
+    if (g_thread_block_key != FLS_OUT_OF_INDEXES) {
+        FlsSetValue(g_thread_block_key, blk);
     }
 }
 #else
-static ss_signal_t* find_signal(const char* name) {
-    ss_signal_t* sig;
-    if (!g_context || !name) return NULL;
-    
-    sig = g_context->signals;
-    while (sig) {
-        if (strcmp(sig->name, name) == 0)
-            return sig;
-        sig = sig->next;
-    }
-    return NULL;
+static pthread_key_t g_thread_block_key;
+static pthread_once_t g_thread_block_once = PTHREAD_ONCE_INIT;
+static int g_thread_block_key_ok = 0;
+
+static void thread_block_release(void* blk) {
+    SS_ATOMIC_STORE(&((ss_thread_block_t*)blk)->b.state, SS_TBLOCK_RELEASED);
+    t_thread_block = NULL;
 }
-#endif
 
-/* Sweep slots marked as removed after emission completes */
-static void sweep_removed_slots(ss_signal_t* sig) {
-    ss_slot_t* prev = NULL;
-    ss_slot_t* curr = sig->slots;
-    while (curr) {
-        ss_slot_t* next = curr->next;
-        if (curr->removed) {
-            if (prev) {
-                prev->next = next;
-            } else {
-                sig->slots = next;
-            }
-            sig->slot_count--;
-#if SS_USE_STATIC_MEMORY
-            free_slot(curr);
+static void thread_block_key_create(void) {
+    g_thread_block_key_ok =
+        pthread_key_create(&g_thread_block_key, thread_block_release) == 0;
+}
+
+static void thread_block_register(ss_thread_block_t* blk) {
+    pthread_once(&g_thread_block_once, thread_block_key_create);
+    if (g_thread_block_key_ok) pthread_setspecific(g_thread_block_key, blk);
+}
+#endif
 #else
-            SS_FREE(curr);
+#define thread_block_register(blk) ((void)0)
 #endif
-        } else {
-            prev = curr;
+
+/* Take a block for the calling thread, never-used ones first so exited
+ * threads stay visible as long as possible */
+static ss_thread_block_t* thread_block_claim(void) {
+    static const int from[2] = { SS_TBLOCK_UNUSED, SS_TBLOCK_RELEASED };
+    ss_thread_block_t* blk;
+    uint32_t i, used;
+    int pass;
+
+    for (pass = 0; pass < 2; pass++) {
+        for (i = 0; i < SS_MAX_THREAD_STATS - 1; i++) {
+            blk = &g_thread_blocks[i];
+            while (SS_ATOMIC_LOAD(&blk->b.state) == from[pass]) {
+                int expected = from[pass];
+                if (!SS_ATOMIC_CAS(&blk->b.state, &expected, SS_TBLOCK_OWNED)) {
+                    continue;
+                }
+                memset(blk->b.stats.name, 0, SS_THREAD_NAME_LENGTH);
+                thread_block_zero(blk);
+                blk->b.stats.thread_id = current_thread_id();
+                SS_ATOMIC_STORE(&blk->b.epoch,
+                                SS_ATOMIC_LOAD(&g_thread_stats_epoch));
+                used = SS_ATOMIC_LOAD(&g_thread_blocks_used);
+                while (used < i + 1 &&
+                       !SS_ATOMIC_CAS(&g_thread_blocks_used, &used, i + 1)) {
+                }
+                thread_block_register(blk);
+                return blk;
+            }
         }
-        curr = next;
     }
+
+    blk = &g_thread_blocks[SS_MAX_THREAD_STATS - 1];
+    if (!blk->b.shared) {
+        ss_strscpy(blk->b.stats.name, "(overflow)", SS_THREAD_NAME_LENGTH);
+        blk->b.shared = 1;
+        SS_ATOMIC_STORE(&blk->b.state, SS_TBLOCK_OWNED);
+        SS_ATOMIC_STORE(&g_thread_blocks_used, SS_MAX_THREAD_STATS);
+    }
+    return blk;
 }
 
-/* Error handler */
-static void report_error(ss_error_t error, const char* msg) {
-    if (g_context && g_context->error_handler) {
-        g_context->error_handler(error, msg);
+static ss_thread_block_t* thread_block(void) {
+    ss_thread_block_t* blk = t_thread_block;
+    uint32_t epoch = SS_ATOMIC_LOAD(&g_thread_stats_epoch);
+    uint32_t seen;
+
+    if (!blk) blk = t_thread_block = thread_block_claim();
+    seen = SS_ATOMIC_LOAD(&blk->b.epoch);
+    if (seen != epoch) {
+        /* A reset happened: the owner, or one sharer, zeroes the block */
+        if (!blk->b.shared) {
+            thread_block_zero(blk);
+            SS_ATOMIC_STORE(&blk->b.epoch, epoch);
+        } else if (SS_ATOMIC_CAS(&blk->b.epoch, &seen, epoch)) {
+            thread_block_zero(blk);
+        }
     }
+    return blk;
 }
 
-/* Core implementation */
-ss_error_t ss_init(void) {
-    if (g_context) return SS_OK;
-    
-    g_context = (ss_context_t*)SS_CALLOC(1, sizeof(ss_context_t));
-    if (!g_context) return SS_ERR_MEMORY;
-    
-    g_context->max_slots_per_signal = SS_DEFAULT_MAX_SLOTS_PER_SIGNAL;
-    g_context->thread_safe = 0;  /* Thread safety disabled by default, enable with ss_set_thread_safe(1) */
-    g_context->next_handle = 1;
+#define THREAD_STAT_ADD(blk, field, v) \
+    ((blk)->b.shared ? (void)SS_ATOMIC_FETCH_ADD(&(blk)->b.stats.field, (v)) \
+                     : SS_ATOMIC_STORE(&(blk)->b.stats.field, \
+                                       SS_ATOMIC_LOAD(&(blk)->b.stats.field) + (v)))
+#endif
 
-    SS_TRACE("Signal-slot library initialized");
-    return SS_OK;
+#if SS_ENABLE_THREAD_SAFETY && (SS_ENABLE_USDT || SS_ENABLE_THREAD_STATS)
+/*
+ * Try the lock first so the uncontended path costs the same as a plain
+ * lock; only a thread that has to wait reads the clock, fires
+ * ss:lock_wait(mutex, wait_ns) and charges the wait to its thread stats.
+ */
+static void mutex_lock_probed(ss_mutex_t* m) {
+    uint64_t start, waited;
+    if (SS_MUTEX_TRYLOCK(m)) return;
+    start = monotonic_clock(NULL);
+    SS_MUTEX_ACQUIRE(m);
+    waited = monotonic_clock(NULL) - start;
+    SS_USDT2(lock_wait, m, waited);
+#if SS_ENABLE_THREAD_STATS
+    if (g_context && g_context->thread_stats_enabled) {
+        ss_thread_block_t* blk = thread_block();
+        THREAD_STAT_ADD(blk, lock_waits, 1);
+        THREAD_STAT_ADD(blk, lock_wait_ns, waited);
+    }
+#else
+    (void)waited;
+#endif
 }
+#endif
 
-ss_error_t ss_init_static(void* memory_pool, size_t pool_size) {
-    /* For future implementation of custom memory pool */
-    (void)memory_pool;
-    (void)pool_size;
-    return ss_init();
+#if SS_NEED_CLOCK
+#if SS_ENABLE_TSC_CLOCK
+/*
+ * TSC calibration, shared by all contexts and computed once per process.
+ * ns = ns_base + ((tsc - tsc_base) * mult) >> 32, which keeps TSC
+ * timestamps on the CLOCK_MONOTONIC timeline.
+ */
+static struct {
+    int state;          /* 0 = not calibrated, 1 = usable, -1 = unusable */
+    int has_rdtscp;
+    uint64_t tsc_base;
+    uint64_t ns_base;
+    uint64_t mult;
+} g_tsc;
+
+static inline uint64_t read_tsc(void) {
+    uint32_t lo, hi;
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
 }
 
-void ss_cleanup(void) {
-    if (!g_context) return;
-    
-#if SS_USE_STATIC_MEMORY
-    /* Free dynamically-allocated description strings before clearing */
-    {
-        size_t i;
-        for (i = 0; i < SS_MAX_SIGNALS; i++) {
+/* rdtscp waits for earlier instructions, so end timestamps are not early */
+static inline uint64_t read_tscp(void) {
+    uint32_t lo, hi, aux;
+    __asm__ volatile("rdtscp" : "=a"(lo), "=d"(hi), "=c"(aux));
+    (void)aux;
+    return ((uint64_t)hi << 32) | lo;
+}
+
+__extension__ typedef __int128 ss_int128_t;
+
+static inline uint64_t tsc_to_ns(uint64_t tsc) {
+    int64_t delta = (int64_t)(tsc - g_tsc.tsc_base);
+    return g_tsc.ns_base +
+           (uint64_t)(((ss_int128_t)delta * (ss_int128_t)g_tsc.mult) >> 32);
+}
+
+static uint64_t tsc_clock(void* user_data) {
+    (void)user_data;
+    return tsc_to_ns(read_tsc());
+}
+
+static uint64_t tscp_clock(void* user_data) {
+    (void)user_data;
+    return tsc_to_ns(read_tscp());
+}
+
+static int tsc_calibrate(void) {
+    unsigned eax, ebx, ecx, edx;
+    uint64_t t0, t1, c0, c1;
+
+    if (g_tsc.state) return g_tsc.state > 0;
+
+    /* Only an invariant TSC ticks at a constant rate across P/C-states */
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) || !(edx & (1u << 8))) {
+        g_tsc.state = -1;
+        return 0;
+    }
+    g_tsc.has_rdtscp = __get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx) &&
+                       (edx & (1u << 27));
+
+    t0 = monotonic_clock(NULL);
+    c0 = read_tsc();
+    do {
+        t1 = monotonic_clock(NULL);
+    } while (t1 - t0 < SS_TSC_CALIBRATION_NS);
+    c1 = read_tsc();
+
+    if (c1 <= c0) {
+        g_tsc.state = -1;
+        return 0;
+    }
+    g_tsc.mult = ((t1 - t0) << 32) / (c1 - c0);
+    g_tsc.tsc_base = c1;
+    g_tsc.ns_base = t1;
+    g_tsc.state = 1;
+    return 1;
+}
+#endif
+
+static ss_clock_func_t default_clock(void) {
+#if SS_ENABLE_TSC_CLOCK
+    if (tsc_calibrate()) return g_tsc.has_rdtscp ? tscp_clock : tsc_clock;
+#endif
+    return monotonic_clock;
+}
+
+static uint64_t get_time_ns(void) {
+    return g_context->clock_func(g_context->clock_user_data);
+}
+#endif
+
+#if SS_NEED_HISTOGRAM
+#define SS_HIST_SUB_BITS SS_PERF_HISTOGRAM_SUB_BUCKET_BITS
+#define SS_HIST_SUB_COUNT ((uint64_t)1 << SS_HIST_SUB_BITS)
+#define SS_HIST_MAX_VALUE (((uint64_t)1 << SS_PERF_HISTOGRAM_MAX_BITS) - 1)
+
+#if SS_PERF_HISTOGRAM_MAX_BITS > 63 || \
+    SS_PERF_HISTOGRAM_SUB_BUCKET_BITS >= SS_PERF_HISTOGRAM_MAX_BITS
+#error "invalid SS_PERF_HISTOGRAM_* configuration"
+#endif
+
+/* Index of the most significant set bit; v must be non-zero */
+static unsigned msb64(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - (unsigned)__builtin_clzll(v);
+#else
+    unsigned n = 0;
+    while (v >>= 1) n++;
+    return n;
+#endif
+}
+
+/*
+ * Values below 2^(SUB_BITS+1) map to themselves; above that each power of
+ * two is split into SUB_COUNT linear buckets. OR-ing in SUB_COUNT folds the
+ * small-value range into the same formula, so there is no branch.
+ */
+static size_t histogram_index(uint64_t v) {
+    unsigned shift;
+    v = v < SS_HIST_MAX_VALUE ? v : SS_HIST_MAX_VALUE;
+    shift = msb64(v | SS_HIST_SUB_COUNT) - SS_HIST_SUB_BITS;
+    return ((size_t)shift << SS_HIST_SUB_BITS) + (size_t)(v >> shift);
+}
+
+/* Highest value that maps to bucket idx */
+static uint64_t histogram_bucket_upper(size_t idx) {
+    size_t shift = idx >> SS_HIST_SUB_BITS;
+    uint64_t base;
+    shift = shift ? shift - 1 : 0;
+    base = (uint64_t)(idx - (shift << SS_HIST_SUB_BITS)) << shift;
+    return base + ((uint64_t)1 << shift) - 1;
+}
+
+void ss_histogram_reset(ss_histogram_t* hist) {
+    if (hist) memset(hist, 0, sizeof(ss_histogram_t));
+}
+
+void ss_histogram_record(ss_histogram_t* hist, uint64_t value_ns) {
+    hist->counts[histogram_index(value_ns)]++;
+    hist->total_count++;
+    hist->max_value = value_ns > hist->max_value ? value_ns : hist->max_value;
+}
+
+void ss_histogram_merge(ss_histogram_t* dst, const ss_histogram_t* src) {
+    size_t i;
+    if (!dst || !src) return;
+    for (i = 0; i < SS_PERF_HISTOGRAM_BUCKETS; i++) {
+        dst->counts[i] += src->counts[i];
+    }
+    dst->total_count += src->total_count;
+    if (src->max_value > dst->max_value) dst->max_value = src->max_value;
+}
+
+/* Upper bound of the bucket holding the given percentile (0-100) */
+uint64_t ss_histogram_percentile(const ss_histogram_t* hist, double percentile) {
+    uint64_t target, seen = 0;
+    size_t i;
+
+    if (!hist || hist->total_count == 0) return 0;
+    if (percentile >= 100.0) return hist->max_value;
+    if (percentile < 0.0) percentile = 0.0;
+
+    target = (uint64_t)((percentile / 100.0) * (double)hist->total_count + 0.5);
+    if (target == 0) target = 1;
+
+    for (i = 0; i < SS_PERF_HISTOGRAM_BUCKETS; i++) {
+        seen += hist->counts[i];
+        if (seen >= target) {
+            uint64_t upper = histogram_bucket_upper(i);
+            return upper < hist->max_value ? upper : hist->max_value;
+        }
+    }
+    return hist->max_value;
+}
+#endif
+
+#if SS_ENABLE_PERFORMANCE_STATS
+/*
+ * Per-thread xorshift32 decides which emissions are timed. A threshold of
+ * UINT32_MAX / n gives a 1-in-n sampling probability; UINT32_MAX times all.
+ */
+static SS_THREAD_LOCAL uint32_t t_sample_state = 0;
+
+static int profiling_sample(uint32_t threshold) {
+    uint32_t x = t_sample_state;
+    if (x == 0) {
+        x = 0x9E3779B9u ^ (uint32_t)(uintptr_t)&t_sample_state;
+        if (x == 0) x = 1;
+    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    t_sample_state = x;
+    return x <= threshold;
+}
+
+static uint32_t sample_threshold_for(uint32_t one_in_n) {
+    return one_in_n <= 1 ? UINT32_MAX : UINT32_MAX / one_in_n;
+}
+
+/* Fill the derived fields, scaling sampled time up to all emissions */
+static void perf_stats_snapshot(const ss_signal_t* sig, ss_perf_stats_t* out) {
+    *out = sig->perf_stats;
+    if (out->sampled_emissions > 0) {
+        out->avg_time_ns = out->sampled_time_ns / out->sampled_emissions;
+        out->total_time_ns = (uint64_t)((double)out->sampled_time_ns *
+                                        (double)out->total_emissions /
+                                        (double)out->sampled_emissions);
+    }
+}
+#endif
+
+#if SS_ENABLE_QUEUE_STATS
+static void queue_record_flush(ss_queue_stats_t* stats, size_t entries,
+                               uint64_t elapsed_ns) {
+    stats->flushes++;
+    stats->flushed += entries;
+    stats->flush_time_ns += elapsed_ns;
+    ss_histogram_record(&stats->flush_histogram, elapsed_ns);
+}
+#endif
+
+#if SS_ENABLE_TRACE_BUFFER
+#if (SS_TRACE_BUFFER_SIZE & (SS_TRACE_BUFFER_SIZE - 1)) != 0
+#error "SS_TRACE_BUFFER_SIZE must be a power of two"
+#endif
+
+static void trace_record(uint8_t type, const char* name,
+                         ss_slot_func_t slot, uint64_t flow_id) {
+    uint64_t idx = SS_ATOMIC_FETCH_ADD(&g_context->trace_head, 1);
+    ss_trace_record_t* rec =
+        &g_context->trace_records[idx & (SS_TRACE_BUFFER_SIZE - 1)];
+
+    rec->timestamp_ns = get_time_ns();
+    rec->flow_id = flow_id;
+    rec->slot = slot;
+    rec->thread_id = current_thread_id();
+    rec->type = type;
+    ss_strscpy(rec->name, name, SS_TRACE_NAME_LENGTH);
+}
+
+#define SS_TRACE_EVENT(type, name, slot, flow) do { \
+    if (g_context->trace_recording) trace_record((type), (name), (slot), (flow)); \
+} while (0)
+#else
+#define SS_TRACE_EVENT(type, name, slot, flow) ((void)0)
+#endif
+
+#if SS_USE_STATIC_MEMORY
+static ss_signal_t* find_signal(const char* name) {
+    size_t i;
+    if (!g_context || !name) return NULL;
+    
+    for (i = 0; i < SS_MAX_SIGNALS; i++) {
+        if (g_context->signal_used[i] && 
+            strcmp(g_context->signals[i].name, name) == 0) {
+            return &g_context->signals[i];
+        }
+    }
+    return NULL;
+}
+
+static ss_slot_t* allocate_slot(void) {
+    size_t i;
+    for (i = 0; i < SS_MAX_SLOTS; i++) {
+        if (!g_context->slot_used[i]) {
+            g_context->slot_used[i] = 1;
+            g_context->slot_count++;
+#if SS_ENABLE_MEMORY_STATS
+            alloc_account(SS_ALLOC_SLOTS, sizeof(ss_slot_t));
+#endif
+
+            return &g_context->slots[i];
+        }
+    }
+    return NULL;
+}
+
+static void free_slot(ss_slot_t* slot) {
+    size_t index = slot - g_context->slots;
+    if (index < SS_MAX_SLOTS) {
+        g_context->slot_used[index] = 0;
+        g_context->slot_count--;
+        memset(slot, 0, sizeof(ss_slot_t));
+#if SS_ENABLE_MEMORY_STATS
+        alloc_release(SS_ALLOC_SLOTS, sizeof(ss_slot_t));
+#endif
+    }
+}
+#else
+static ss_signal_t* find_signal(const char* name) {
+    ss_signal_t* sig;
+    if (!g_context || !name) return NULL;
+    
+    sig = g_context->signals;
+    while (sig) {
+        if (strcmp(sig->name, name) == 0)
+            return sig;
+        sig = sig->next;
+    }
+    return NULL;
+}
+#endif
+
+#if SS_ENABLE_INTROSPECTION || SS_ENABLE_HOT_SIGNALS || SS_ENABLE_WASTE_STATS || \
+    SS_ENABLE_CALL_GRAPH
+/* Iterate registered signals in either memory model; NULL starts over */
+static ss_signal_t* next_signal(ss_signal_t* prev) {
+#if SS_USE_STATIC_MEMORY
+    size_t i = prev ? (size_t)(prev - g_context->signals) + 1 : 0;
+    for (; i < SS_MAX_SIGNALS; i++) {
+        if (g_context->signal_used[i]) return &g_context->signals[i];
+    }
+    return NULL;
+#else
+    return prev ? prev->next : g_context->signals;
+#endif
+}
+#endif
+
+#if SS_ENABLE_HOT_SIGNALS || SS_ENABLE_CALL_GRAPH
+static ss_signal_t* find_signal_by_id(uint32_t id) {
+    ss_signal_t* sig;
+    for (sig = next_signal(NULL); sig; sig = next_signal(sig)) {
+        if (sig->id == id) return sig;
+    }
+    return NULL;
+}
+#endif
+
+#if SS_ENABLE_HOT_SIGNALS
+
+/*
+ * Space-Saving: a signal already in the table accumulates its weight; a new
+ * one replaces the lightest entry and inherits its weight as error bound.
+ * The per-signal hint makes the common case a single comparison.
+ */
+static void hot_table_add(ss_hot_entry_t* table, uint32_t id, uint64_t weight,
+                          uint16_t* hint) {
+    size_t i, lightest = 0;
+
+    if (table[*hint].signal_id == id) {
+        table[*hint].weight += weight;
+        return;
+    }
+    for (i = 0; i < SS_HOT_SIGNALS_CAPACITY; i++) {
+        if (table[i].signal_id == id) {
+            table[i].weight += weight;
+            *hint = (uint16_t)i;
+            return;
+        }
+        if (table[i].weight < table[lightest].weight) lightest = i;
+    }
+    table[lightest].signal_id = id;
+    table[lightest].error = table[lightest].weight;
+    table[lightest].weight += weight;
+    *hint = (uint16_t)lightest;
+}
+
+static const ss_hot_entry_t* hot_table_find(const ss_hot_entry_t* table,
+                                            uint32_t id) {
+    size_t i;
+    for (i = 0; i < SS_HOT_SIGNALS_CAPACITY; i++) {
+        if (table[i].signal_id == id) return &table[i];
+    }
+    return NULL;
+}
+
+static void hot_table_decay(ss_hot_entry_t* table, uint64_t shift) {
+    size_t i;
+    for (i = 0; i < SS_HOT_SIGNALS_CAPACITY; i++) {
+        table[i].weight = shift >= 64 ? 0 : table[i].weight >> shift;
+        table[i].error = shift >= 64 ? 0 : table[i].error >> shift;
+    }
+}
+
+/* Halving once per elapsed window approximates a sliding window */
+static void hot_signals_record(ss_signal_t* sig, uint64_t start, uint64_t now) {
+    uint64_t windows = (now - g_context->hot_window_start) / SS_HOT_SIGNALS_DECAY_NS;
+
+    if (windows > 0) {
+        hot_table_decay(g_context->hot_by_count, windows);
+        hot_table_decay(g_context->hot_by_time, windows);
+        g_context->hot_window_start = now;
+    }
+    hot_table_add(g_context->hot_by_count, sig->id, 1, &sig->hot_hint[0]);
+    hot_table_add(g_context->hot_by_time, sig->id, now - start, &sig->hot_hint[1]);
+}
+#endif
+
+#if SS_ENABLE_CALL_GRAPH
+/* Emissions in progress on this thread, innermost last */
+static SS_THREAD_LOCAL struct {
+    uint32_t ids[SS_CALL_GRAPH_MAX_DEPTH];
+    uint64_t start_ns[SS_CALL_GRAPH_MAX_DEPTH];
+    uint64_t child_ns[SS_CALL_GRAPH_MAX_DEPTH];
+    size_t depth;          /* May exceed the array; deeper levels untracked */
+} t_call_stack;
+
+static void call_graph_add_edge(uint32_t parent, uint32_t child,
+                                uint64_t inclusive, uint64_t exclusive) {
+    size_t mask = SS_CALL_GRAPH_MAX_EDGES - 1;
+    size_t i = ((size_t)parent * 2654435761u ^ child) & mask;
+    size_t probes;
+
+    for (probes = 0; probes < SS_CALL_GRAPH_MAX_EDGES; probes++) {
+        ss_call_edge_t* e = &g_context->call_edges[i];
+        if (e->child_id == 0) {
+            e->parent_id = parent;
+            e->child_id = child;
+            g_context->call_edge_count++;
+        }
+        if (e->parent_id == parent && e->child_id == child) {
+            e->count++;
+            e->inclusive_ns += inclusive;
+            e->exclusive_ns += exclusive;
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+    g_context->call_edges_dropped++;
+}
+
+static void call_graph_push(uint32_t id, uint64_t start) {
+    size_t d = t_call_stack.depth++;
+    if (d >= SS_CALL_GRAPH_MAX_DEPTH) {
+        g_context->call_depth_truncated++;
+        return;
+    }
+    t_call_stack.ids[d] = id;
+    t_call_stack.child_ns[d] = 0;
+    t_call_stack.start_ns[d] = start;
+}
+
+/* Close the innermost emission and charge its time to the parent */
+static void call_graph_pop(uint64_t end) {
+    size_t d = --t_call_stack.depth;
+    uint64_t elapsed, child;
+
+    if (d >= SS_CALL_GRAPH_MAX_DEPTH) return;
+    elapsed = end - t_call_stack.start_ns[d];
+    child = t_call_stack.child_ns[d];
+    call_graph_add_edge(d > 0 ? t_call_stack.ids[d - 1] : 0, t_call_stack.ids[d],
+                        elapsed, elapsed > child ? elapsed - child : 0);
+    if (d > 0) t_call_stack.child_ns[d - 1] += elapsed;
+}
+#endif
+
+/* Return a disconnected slot to the pool or heap */
+static void release_slot(ss_slot_t* slot) {
+#if SS_ENABLE_MEMORY_STATS
+    g_context->memory_stats.slots_used--;
+#endif
+#if SS_USE_STATIC_MEMORY
+    free_slot(slot);
+#else
+    SS_ACCT_FREE(SS_ALLOC_SLOTS, slot, sizeof(ss_slot_t));
+#endif
+}
+
+/* Sweep slots marked as removed after emission completes */
+static void sweep_removed_slots(ss_signal_t* sig) {
+    ss_slot_t* prev = NULL;
+    ss_slot_t* curr = sig->slots;
+    while (curr) {
+        ss_slot_t* next = curr->next;
+        if (curr->removed) {
+            if (prev) {
+                prev->next = next;
+            } else {
+                sig->slots = next;
+            }
+            sig->slot_count--;
+            release_slot(curr);
+        } else {
+            prev = curr;
+        }
+        curr = next;
+    }
+}
+
+/* Error handler */
+static void report_error(ss_error_t error, const char* msg) {
+    if (g_context && g_context->error_handler) {
+        g_context->error_handler(error, msg);
+    }
+}
+
+/* Core implementation */
+ss_error_t ss_init(void) {
+    if (g_context) return SS_OK;
+    
+    g_context = (ss_context_t*)SS_ACCT_CALLOC(SS_ALLOC_OTHER, 1,
+                                              sizeof(ss_context_t));
+    if (!g_context) return SS_ERR_MEMORY;
+    
+    g_context->max_slots_per_signal = SS_DEFAULT_MAX_SLOTS_PER_SIGNAL;
+    g_context->thread_safe = 0;  /* Thread safety disabled by default, enable with ss_set_thread_safe(1) */
+    g_context->next_handle = 1;
+#if SS_ENABLE_PERFORMANCE_STATS
+    g_context->sample_threshold = UINT32_MAX;
+#endif
+#if SS_NEED_CLOCK
+    g_context->clock_func = default_clock();
+#endif
+    select_emit_path();
+
+    SS_TRACE("Signal-slot library initialized");
+    return SS_OK;
+}
+
+ss_error_t ss_init_static(void* memory_pool, size_t pool_size) {
+    /* For future implementation of custom memory pool */
+    (void)memory_pool;
+    (void)pool_size;
+    return ss_init();
+}
+
+void ss_cleanup(void) {
+    if (!g_context) return;
+    
+    /* Free pending deferred emission strings */
+    {
+        size_t i;
+        for (i = 0; i < g_context->deferred_count; i++) {
+            ss_deferred_entry_t* entry = &g_context->deferred_queue[
+                (g_context->deferred_head + i) % SS_DEFERRED_QUEUE_SIZE];
+            if (entry->has_string) {
+                SS_ACCT_FREE_STRING(SS_ALLOC_PAYLOADS, entry->data.value.s_val);
+            }
+        }
+    }
+
+#if SS_USE_STATIC_MEMORY
+    /* Free dynamically-allocated description strings before clearing */
+    {
+        size_t i;
+        for (i = 0; i < SS_MAX_SIGNALS; i++) {
             if (g_context->signal_used[i] && g_context->signals[i].description) {
-                SS_FREE(g_context->signals[i].description);
+                SS_ACCT_FREE_STRING(SS_ALLOC_NAMES,
+                                    g_context->signals[i].description);
             }
+#if SS_ENABLE_MEMORY_STATS
+            if (g_context->signal_used[i]) {
+                alloc_release(SS_ALLOC_SIGNALS, sizeof(ss_signal_t));
+            }
+#endif
         }
+#if SS_ENABLE_MEMORY_STATS
+        for (i = 0; i < SS_MAX_SLOTS; i++) {
+            if (g_context->slot_used[i]) {
+                alloc_release(SS_ALLOC_SLOTS, sizeof(ss_slot_t));
+            }
+        }
+#endif
     }
     memset(g_context, 0, sizeof(ss_context_t));
 #else
@@ -280,15 +1308,18 @@ void ss_cleanup(void) {
         
         while (slot) {
             ss_slot_t* next_slot = slot->next;
-            SS_FREE(slot);
+            SS_ACCT_FREE(SS_ALLOC_SLOTS, slot, sizeof(ss_slot_t));
             slot = next_slot;
         }
         
-        SS_FREE(sig->name);
-        if (sig->description) SS_FREE(sig->description);
-        SS_FREE(sig);
+        SS_ACCT_FREE_STRING(SS_ALLOC_NAMES, sig->name);
+        if (sig->description) SS_ACCT_FREE_STRING(SS_ALLOC_NAMES, sig->description);
+        SS_ACCT_FREE(SS_ALLOC_SIGNALS, sig, sizeof(ss_signal_t));
         sig = next_sig;
     }
+#if SS_ENABLE_INTROSPECTION
+    g_registry_generation++;
+#endif
 #endif
 
     
@@ -298,19 +1329,11 @@ void ss_cleanup(void) {
     }
 #endif
 
-    
-    /* Free pending deferred emission strings */
-    {
-        size_t i;
-        for (i = 0; i < g_context->deferred_count; i++) {
-            if (g_context->deferred_queue[i].has_string) {
-                SS_FREE((void*)g_context->deferred_queue[i].data.value.s_val);
-            }
-        }
-    }
 
-    if (g_context->namespace) SS_FREE(g_context->namespace);
-    SS_FREE(g_context);
+    if (g_context->namespace) {
+        SS_ACCT_FREE_STRING(SS_ALLOC_NAMES, g_context->namespace);
+    }
+    SS_ACCT_FREE(SS_ALLOC_OTHER, g_context, sizeof(ss_context_t));
     g_context = NULL;
     
     SS_TRACE("Signal-slot library cleaned up");
@@ -353,7 +1376,11 @@ ss_error_t ss_signal_register_ex(const char* signal_name,
     for (i = 0; i < SS_MAX_SIGNALS; i++) {
         if (!g_context->signal_used[i]) {
             new_sig = &g_context->signals[i];
+            memset(new_sig, 0, sizeof(ss_signal_t));  /* Drop stale stats */
             g_context->signal_used[i] = 1;
+#if SS_ENABLE_MEMORY_STATS
+            alloc_account(SS_ALLOC_SIGNALS, sizeof(ss_signal_t));
+#endif
             
             /* Use pre-allocated name buffer */
             ss_strscpy(g_context->signal_names[i], signal_name,
@@ -371,7 +1398,8 @@ ss_error_t ss_signal_register_ex(const char* signal_name,
         return SS_ERR_WOULD_OVERFLOW;
     }
 #else
-    new_sig = (ss_signal_t*)SS_CALLOC(1, sizeof(ss_signal_t));
+    new_sig = (ss_signal_t*)SS_ACCT_CALLOC(SS_ALLOC_SIGNALS, 1,
+                                           sizeof(ss_signal_t));
     if (!new_sig) {
 #if SS_ENABLE_THREAD_SAFETY
         if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
@@ -380,9 +1408,9 @@ ss_error_t ss_signal_register_ex(const char* signal_name,
         return SS_ERR_MEMORY;
     }
     
-    new_sig->name = SS_STRDUP(signal_name);
+    new_sig->name = SS_ACCT_STRDUP(SS_ALLOC_NAMES, signal_name);
     if (!new_sig->name) {
-        SS_FREE(new_sig);
+        SS_ACCT_FREE(SS_ALLOC_SIGNALS, new_sig, sizeof(ss_signal_t));
 #if SS_ENABLE_THREAD_SAFETY
         if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
 #endif
@@ -393,13 +1421,17 @@ ss_error_t ss_signal_register_ex(const char* signal_name,
 
     
     if (description) {
-        new_sig->description = SS_STRDUP(description);
+        new_sig->description = SS_ACCT_STRDUP(SS_ALLOC_NAMES, description);
     }
     new_sig->priority = priority;
+    new_sig->id = ++g_context->next_signal_id;
     
 #if !SS_USE_STATIC_MEMORY
     new_sig->next = g_context->signals;
     g_context->signals = new_sig;
+#if SS_ENABLE_INTROSPECTION
+    g_registry_generation++;
+#endif
 #endif
 
     
@@ -407,12 +1439,6 @@ ss_error_t ss_signal_register_ex(const char* signal_name,
     
 #if SS_ENABLE_MEMORY_STATS
     g_context->memory_stats.signals_used = g_context->signal_count;
-#if SS_USE_STATIC_MEMORY
-    g_context->memory_stats.signals_allocated = SS_MAX_SIGNALS;
-    g_context->memory_stats.slots_allocated = SS_MAX_SLOTS;
-#else  
-    g_context->memory_stats.signals_allocated++;
-#endif
 #endif
 
     
@@ -472,7 +1498,7 @@ ss_error_t ss_connect_ex(const char* signal_name, ss_slot_func_t slot,
         return SS_ERR_WOULD_OVERFLOW;
     }
 #else
-    new_slot = (ss_slot_t*)SS_CALLOC(1, sizeof(ss_slot_t));
+    new_slot = (ss_slot_t*)SS_ACCT_CALLOC(SS_ALLOC_SLOTS, 1, sizeof(ss_slot_t));
     if (!new_slot) {
 #if SS_ENABLE_THREAD_SAFETY
         if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
@@ -508,23 +1534,7 @@ ss_error_t ss_connect_ex(const char* signal_name, ss_slot_func_t slot,
     sig->slot_count++;
     
 #if SS_ENABLE_MEMORY_STATS
-    /* Update total slot count across all signals */
-    size_t total_slots = 0;
-#if SS_USE_STATIC_MEMORY
-    size_t i;
-    for (i = 0; i < SS_MAX_SIGNALS; i++) {
-        if (g_context->signal_used[i]) {
-            total_slots += g_context->signals[i].slot_count;
-        }
-    }
-#else
-    ss_signal_t* s = g_context->signals;
-    while (s) {
-        total_slots += s->slot_count;
-        s = s->next;
-    }
-#endif
-    g_context->memory_stats.slots_used = total_slots;
+    g_context->memory_stats.slots_used++;
 #endif
 
     
@@ -538,130 +1548,404 @@ ss_error_t ss_connect_ex(const char* signal_name, ss_slot_func_t slot,
     return SS_OK;
 }
 
-ss_error_t ss_emit(const char* signal_name, const ss_data_t* data) {
-    ss_signal_t* sig;
+#if SS_ENABLE_HOOKS
+/*
+ * Slot loop with hooks. Kept out of ss_emit so that without hooks the
+ * emit path only pays the hooks_active test. Hooks are read once, so a
+ * hook that replaces the hooks takes effect from the next emission.
+ */
+static size_t invoke_slots_hooked(ss_signal_t* sig, const ss_data_t* data) {
+    ss_hook_func_t emit_pre = g_context->emit_pre_hook;
+    ss_hook_func_t emit_post = g_context->emit_post_hook;
+    void* emit_ctx = g_context->emit_hook_ctx;
+    ss_hook_func_t slot_pre = g_context->slot_pre_hook;
+    ss_hook_func_t slot_post = g_context->slot_post_hook;
+    void* slot_ctx = g_context->slot_hook_ctx;
+    ss_hook_info_t info;
     ss_slot_t* slot;
-#if SS_ENABLE_PERFORMANCE_STATS
-    uint64_t start_time = 0;
+    uint64_t emit_start;
+    size_t invoked = 0;
+
+    memset(&info, 0, sizeof(info));
+    info.signal_id = sig->id;
+    info.signal_name = sig->name;
+    info.data = data;
+    info.slot_count = sig->slot_count;
+    info.timestamp_ns = get_time_ns();
+    if (emit_pre) emit_pre(&info, emit_ctx);
+    emit_start = emit_pre ? get_time_ns() : info.timestamp_ns;
+
+    slot = sig->slots;
+    while (slot) {
+        ss_slot_t* next_slot = slot->next;
+        if (!slot->removed) {
+            uint64_t slot_start = 0;
+            if (slot_pre || slot_post) {
+                info.slot = slot->func;
+                info.slot_user_data = slot->user_data;
+                info.elapsed_ns = 0;
+                info.timestamp_ns = get_time_ns();
+                if (slot_pre) slot_pre(&info, slot_ctx);
+                slot_start = slot_pre ? get_time_ns() : info.timestamp_ns;
+            }
+            SS_TRACE_EVENT(SS_TREC_SLOT_BEGIN, sig->name, slot->func, 0);
+            SS_USDT3(slot_enter, sig->name, slot->func, slot->user_data);
+            slot->func(data, slot->user_data);
+            SS_USDT2(slot_exit, sig->name, slot->func);
+            SS_TRACE_EVENT(SS_TREC_SLOT_END, sig->name, slot->func, 0);
+            if (slot_post) {
+                info.timestamp_ns = get_time_ns();
+                info.elapsed_ns = info.timestamp_ns - slot_start;
+                slot_post(&info, slot_ctx);
+            }
+            invoked++;
+        }
+        slot = next_slot;
+    }
+
+    if (emit_post) {
+        info.slot = NULL;
+        info.slot_user_data = NULL;
+        info.timestamp_ns = get_time_ns();
+        info.elapsed_ns = info.timestamp_ns - emit_start;
+        emit_post(&info, emit_ctx);
+    }
+    return invoked;
+}
 #endif
-    
-    if (!g_context || !signal_name) {
-        report_error(SS_ERR_NULL_PARAM, "emit requires signal name");
-        return SS_ERR_NULL_PARAM;
+
+#if SS_ENABLE_WASTE_STATS
+static void waste_record(ss_signal_t* sig, int had_slots, size_t invoked) {
+    ss_waste_counters_t* w = &sig->waste;
+    size_t bucket = 0;
+
+    w->emissions++;
+    w->slot_calls += invoked;
+    if (invoked == 0) {
+        if (had_slots) {
+            w->all_removed++;
+        } else {
+            w->zero_slot++;
+        }
+    }
+    while (invoked > 0 && bucket < SS_FANOUT_BUCKETS - 1) {
+        invoked >>= 1;
+        bucket++;
     }
+    w->fanout[bucket]++;
+}
+#endif
+
+#define SS_EMIT_TIMING (SS_ENABLE_PERFORMANCE_STATS || SS_ENABLE_HOT_SIGNALS || \
+                        SS_ENABLE_CALL_GRAPH || SS_ENABLE_THREAD_STATS)
 
+/*
+ * Emission body shared by the dispatch variants below. `locked` and
+ * `instrumented` are compile-time constants in each variant, so the
+ * disabled paths fold away instead of being tested on every emission.
+ * Instrumented covers every runtime-switchable feature that observes
+ * emissions: profiling, hot signals, call graph, thread stats, hooks and
+ * trace recording. The timed features share one start and one end
+ * timestamp, so an emission reads the clock at most twice.
+ */
+static SS_ALWAYS_INLINE ss_error_t emit_impl(const char* signal_name,
+                                             const ss_data_t* data,
+                                             const int locked,
+                                             const int instrumented) {
+    ss_signal_t* sig;
+    ss_slot_t* slot;
+#if SS_EMIT_TIMING
+    uint64_t start_ns = 0;
+    uint64_t end_ns = 0;
+    int clocked = 0;
+#endif
 #if SS_ENABLE_PERFORMANCE_STATS
-    if (g_context->profiling_enabled) {
-        start_time = get_time_ns();
-    }
+    int timed = 0;
+#endif
+#if SS_ENABLE_HOT_SIGNALS
+    int hot = 0;
+#endif
+#if SS_ENABLE_WASTE_STATS || SS_ENABLE_THREAD_STATS
+    size_t invoked = 0;
+#endif
+#if SS_ENABLE_WASTE_STATS
+    int had_slots;
+#endif
+#if SS_ENABLE_CALL_GRAPH
+    int call_tracked = 0;
+#endif
+#if SS_ENABLE_THREAD_STATS
+    ss_thread_block_t* tstats = NULL;
 #endif
 
+    (void)locked;
+    (void)instrumented;
 
 #if SS_ENABLE_THREAD_SAFETY
-    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+    if (locked) SS_MUTEX_LOCK(&g_context->mutex);
 #endif
 
 
     sig = find_signal(signal_name);
     if (!sig) {
+#if SS_ENABLE_WASTE_STATS
+        g_context->not_found_emissions++;
+        ss_strscpy(g_context->last_not_found, signal_name,
+                   SS_MAX_SIGNAL_NAME_LENGTH);
+#endif
 #if SS_ENABLE_THREAD_SAFETY
-        if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+        if (locked) SS_MUTEX_UNLOCK(&g_context->mutex);
 #endif
         report_error(SS_ERR_NOT_FOUND, signal_name);
         return SS_ERR_NOT_FOUND;
     }
     
     SS_TRACE("Emitting signal: %s to %zu slots", signal_name, sig->slot_count);
+    if (instrumented) SS_TRACE_EVENT(SS_TREC_EMIT_BEGIN, sig->name, NULL, 0);
+    SS_USDT3(emit_begin, sig->name, sig->slot_count, data);
+
+#if SS_ENABLE_PERFORMANCE_STATS
+    if (instrumented && g_context->profiling_enabled) {
+        /* Exact count always; timing only for sampled emissions */
+        sig->perf_stats.total_emissions++;
+        timed = profiling_sample(sig->sample_threshold ? sig->sample_threshold
+                                                       : g_context->sample_threshold);
+        clocked |= timed;
+    }
+#endif
+#if SS_ENABLE_HOT_SIGNALS
+    hot = instrumented && g_context->hot_signals_enabled;
+    clocked |= hot;
+#endif
+#if SS_ENABLE_CALL_GRAPH
+    call_tracked = instrumented && g_context->call_graph_enabled;
+    clocked |= call_tracked;
+#endif
+#if SS_ENABLE_THREAD_STATS
+    if (instrumented && g_context->thread_stats_enabled) {
+        tstats = thread_block();
+        clocked = 1;
+    }
+#endif
+#if SS_EMIT_TIMING
+    if (clocked) start_ns = get_time_ns();
+#endif
+#if SS_ENABLE_CALL_GRAPH
+    if (call_tracked) call_graph_push(sig->id, start_ns);
+#endif
     
+#if SS_ENABLE_WASTE_STATS
+    had_slots = sig->slots != NULL;
+#endif
     sig->emitting++;
-    slot = sig->slots;
-    while (slot) {
-        ss_slot_t* next_slot = slot->next;
-        if (!slot->removed) {
-            slot->func(data, slot->user_data);
+#if SS_ENABLE_HOOKS
+    if (instrumented && g_context->hooks_active) {
+#if SS_ENABLE_WASTE_STATS || SS_ENABLE_THREAD_STATS
+        invoked = invoke_slots_hooked(sig, data);
+#else
+        invoke_slots_hooked(sig, data);
+#endif
+    } else
+#endif
+    {
+        slot = sig->slots;
+        while (slot) {
+            ss_slot_t* next_slot = slot->next;
+            if (!slot->removed) {
+                if (instrumented) {
+                    SS_TRACE_EVENT(SS_TREC_SLOT_BEGIN, sig->name, slot->func, 0);
+                }
+                SS_USDT3(slot_enter, sig->name, slot->func, slot->user_data);
+                slot->func(data, slot->user_data);
+                SS_USDT2(slot_exit, sig->name, slot->func);
+                if (instrumented) {
+                    SS_TRACE_EVENT(SS_TREC_SLOT_END, sig->name, slot->func, 0);
+                }
+#if SS_ENABLE_WASTE_STATS || SS_ENABLE_THREAD_STATS
+                invoked++;
+#endif
+            }
+            slot = next_slot;
         }
-        slot = next_slot;
     }
     sig->emitting--;
+#if SS_ENABLE_WASTE_STATS
+    waste_record(sig, had_slots, invoked);
+#endif
+    if (instrumented) SS_TRACE_EVENT(SS_TREC_EMIT_END, sig->name, NULL, 0);
+    SS_USDT1(emit_end, sig->name);
     if (sig->emitting == 0) {
         sweep_removed_slots(sig);
     }
 
+#if SS_EMIT_TIMING
+    if (clocked) end_ns = get_time_ns();
+#endif
+#if SS_ENABLE_HOT_SIGNALS
+    if (hot) hot_signals_record(sig, start_ns, end_ns);
+#endif
+#if SS_ENABLE_CALL_GRAPH
+    if (call_tracked) call_graph_pop(end_ns);
+#endif
+#if SS_ENABLE_THREAD_STATS
+    if (tstats) {
+        THREAD_STAT_ADD(tstats, emissions, 1);
+        THREAD_STAT_ADD(tstats, slot_calls, invoked);
+        THREAD_STAT_ADD(tstats, dispatch_time_ns, end_ns - start_ns);
+    }
+#endif
+
 #if SS_ENABLE_PERFORMANCE_STATS
-    if (g_context->profiling_enabled) {
-        uint64_t elapsed = get_time_ns() - start_time;
-        sig->perf_stats.total_emissions++;
-        sig->perf_stats.total_time_ns += elapsed;
-        sig->perf_stats.avg_time_ns = sig->perf_stats.total_time_ns / 
-                                      sig->perf_stats.total_emissions;
+    if (timed) {
+        uint64_t elapsed = end_ns - start_ns;
+        sig->perf_stats.sampled_emissions++;
+        sig->perf_stats.sampled_time_ns += elapsed;
         if (elapsed > sig->perf_stats.max_time_ns) {
             sig->perf_stats.max_time_ns = elapsed;
         }
         if (sig->perf_stats.min_time_ns == 0 || elapsed < sig->perf_stats.min_time_ns) {
             sig->perf_stats.min_time_ns = elapsed;
         }
+        ss_histogram_record(&sig->latency_histogram, elapsed);
     }
 #endif
 
     
 #if SS_ENABLE_THREAD_SAFETY
-    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+    if (locked) SS_MUTEX_UNLOCK(&g_context->mutex);
 #endif
 
     
     return SS_OK;
 }
 
+static ss_error_t emit_plain(const char* signal_name, const ss_data_t* data) {
+    return emit_impl(signal_name, data, 0, 0);
+}
+
+#if SS_EMIT_INSTRUMENTATION
+static ss_error_t emit_instrumented(const char* signal_name,
+                                    const ss_data_t* data) {
+    return emit_impl(signal_name, data, 0, 1);
+}
+#else
+#define emit_instrumented emit_plain
+#endif
+
+#if SS_ENABLE_THREAD_SAFETY
+static ss_error_t emit_locked(const char* signal_name, const ss_data_t* data) {
+    return emit_impl(signal_name, data, 1, 0);
+}
+
+#if SS_EMIT_INSTRUMENTATION
+static ss_error_t emit_locked_instrumented(const char* signal_name,
+                                           const ss_data_t* data) {
+    return emit_impl(signal_name, data, 1, 1);
+}
+#else
+#define emit_locked_instrumented emit_locked
+#endif
+#else
+#define emit_locked emit_plain
+#define emit_locked_instrumented emit_instrumented
+#endif
+
+/* Indexed by [locked][instrumented] */
+static const ss_emit_func_t g_emit_paths[2][2] = {
+    { emit_plain, emit_instrumented },
+    { emit_locked, emit_locked_instrumented }
+};
+
+/*
+ * Pick the emit variant for the current settings. Called by every setter
+ * that changes one of them; an emission already running finishes on the
+ * variant it started with.
+ */
+static void select_emit_path(void) {
+    int locked = 0;
+    int instrumented = 0;
+
+#if SS_ENABLE_THREAD_SAFETY
+    locked = g_context->thread_safe != 0;
+#endif
+#if SS_ENABLE_PERFORMANCE_STATS
+    instrumented |= g_context->profiling_enabled != 0;
+#endif
+#if SS_ENABLE_HOT_SIGNALS
+    instrumented |= g_context->hot_signals_enabled != 0;
+#endif
+#if SS_ENABLE_CALL_GRAPH
+    instrumented |= g_context->call_graph_enabled != 0;
+#endif
+#if SS_ENABLE_THREAD_STATS
+    instrumented |= g_context->thread_stats_enabled != 0;
+#endif
+#if SS_ENABLE_HOOKS
+    instrumented |= g_context->hooks_active != 0;
+#endif
+#if SS_ENABLE_TRACE_BUFFER
+    instrumented |= g_context->trace_recording != 0;
+#endif
+
+    SS_ATOMIC_STORE(&g_context->emit_path, g_emit_paths[locked][instrumented]);
+}
+
+static SS_ALWAYS_INLINE ss_error_t emit_dispatch(const char* signal_name,
+                                                 const ss_data_t* data) {
+    if (!g_context || !signal_name) {
+        report_error(SS_ERR_NULL_PARAM, "emit requires signal name");
+        return SS_ERR_NULL_PARAM;
+    }
+    return SS_ATOMIC_LOAD(&g_context->emit_path)(signal_name, data);
+}
+
+ss_error_t ss_emit(const char* signal_name, const ss_data_t* data) {
+    return emit_dispatch(signal_name, data);
+}
+
 /* Convenience emission functions */
 ss_error_t ss_emit_void(const char* signal_name) {
     ss_data_t data = {0};
     data.type = SS_TYPE_VOID;
-    return ss_emit(signal_name, &data);
+    return emit_dispatch(signal_name, &data);
 }
 
 ss_error_t ss_emit_int(const char* signal_name, int value) {
     ss_data_t data = {0};
     data.type = SS_TYPE_INT;
     data.value.i_val = value;
-    return ss_emit(signal_name, &data);
+    return emit_dispatch(signal_name, &data);
 }
 
 ss_error_t ss_emit_float(const char* signal_name, float value) {
     ss_data_t data = {0};
     data.type = SS_TYPE_FLOAT;
     data.value.f_val = value;
-    return ss_emit(signal_name, &data);
+    return emit_dispatch(signal_name, &data);
 }
 
 ss_error_t ss_emit_double(const char* signal_name, double value) {
     ss_data_t data = {0};
     data.type = SS_TYPE_DOUBLE;
     data.value.d_val = value;
-    return ss_emit(signal_name, &data);
+    return emit_dispatch(signal_name, &data);
 }
 
 ss_error_t ss_emit_string(const char* signal_name, const char* value) {
     ss_data_t data = {0};
     data.type = SS_TYPE_STRING;
     data.value.s_val = value;
-    return ss_emit(signal_name, &data);
+    return emit_dispatch(signal_name, &data);
 }
 
 ss_error_t ss_emit_pointer(const char* signal_name, void* value) {
     ss_data_t data = {0};
     data.type = SS_TYPE_POINTER;
     data.value.p_val = value;
-    return ss_emit(signal_name, &data);
+    return emit_dispatch(signal_name, &data);
 }
 
 #if SS_ENABLE_ISR_SAFE
-/* ISR-safe emission - minimal overhead, no locks */
-static volatile struct {
-    char signal_name[SS_MAX_SIGNAL_NAME_LENGTH];
-    int value;
-    volatile int pending;
-} g_isr_queue[SS_ISR_QUEUE_SIZE];
-
 /* Portable compiler write barrier for ISR safety */
 #if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
 #include <stdatomic.h>
@@ -682,16 +1966,84 @@ ss_error_t ss_emit_from_isr(const char* signal_name, int value) {
             g_isr_queue[i].value = value;
             SS_WRITE_BARRIER();
             g_isr_queue[i].pending = 1;
+#if SS_ENABLE_QUEUE_STATS
+            {
+                uint32_t depth = ++g_isr_stats.enqueued - g_isr_stats.drained;
+                if (depth > g_isr_stats.high_water) {
+                    g_isr_stats.high_water = depth;
+                }
+            }
+#endif
             return SS_OK;
         }
     }
+#if SS_ENABLE_QUEUE_STATS
+    g_isr_stats.dropped++;
+#endif
     return SS_ERR_WOULD_OVERFLOW;
 }
+
+/* Emit queued ISR signals from thread context, freeing their entries */
+ss_error_t ss_process_isr_queue(void) {
+    char name[SS_MAX_SIGNAL_NAME_LENGTH];
+    ss_error_t result = SS_OK;
+    int i, value;
+#if SS_ENABLE_QUEUE_STATS || SS_ENABLE_USDT
+    uint32_t drained = 0;
+#endif
+#if SS_ENABLE_QUEUE_STATS
+    uint64_t start, elapsed;
+#endif
+
+    if (!g_context) return SS_ERR_NULL_PARAM;
+
+#if SS_ENABLE_QUEUE_STATS
+    start = get_time_ns();
+#endif
+    for (i = 0; i < SS_ISR_QUEUE_SIZE; i++) {
+        ss_error_t err;
+        if (!g_isr_queue[i].pending) continue;
+
+        ss_strscpy(name, (const char*)g_isr_queue[i].signal_name,
+                   SS_MAX_SIGNAL_NAME_LENGTH);
+        value = g_isr_queue[i].value;
+        SS_WRITE_BARRIER();
+        g_isr_queue[i].pending = 0;
+#if SS_ENABLE_QUEUE_STATS
+        g_isr_stats.drained++;
+#endif
+#if SS_ENABLE_QUEUE_STATS || SS_ENABLE_USDT
+        drained++;
+#endif
+
+        err = ss_emit_int(name, value);
+        if (err != SS_OK) result = err;
+    }
+
+#if SS_ENABLE_QUEUE_STATS
+    if (drained > 0) {
+        elapsed = get_time_ns() - start;
+#if SS_ENABLE_THREAD_SAFETY
+        if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+        queue_record_flush(&g_isr_flush_stats, drained, elapsed);
+#if SS_ENABLE_THREAD_SAFETY
+        if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+    }
+#endif
+#if SS_ENABLE_USDT
+    if (drained > 0) SS_USDT2(flush, "isr", drained);
+#endif
+
+    return result;
+}
 #endif
 
 /* Data handling functions */
 ss_data_t* ss_data_create(ss_data_type_t type) {
-    ss_data_t* data = (ss_data_t*)SS_CALLOC(1, sizeof(ss_data_t));
+    ss_data_t* data = (ss_data_t*)SS_ACCT_CALLOC(SS_ALLOC_PAYLOADS, 1,
+                                                 sizeof(ss_data_t));
     if (data) {
         data->type = type;
     }
@@ -702,18 +2054,18 @@ void ss_data_destroy(ss_data_t* data) {
     if (!data) return;
 
     if (data->type == SS_TYPE_STRING && data->value.s_val) {
-        SS_FREE((void*)data->value.s_val);
+        SS_ACCT_FREE_STRING(SS_ALLOC_PAYLOADS, data->value.s_val);
     }
 #if SS_ENABLE_CUSTOM_DATA
     else if (data->type == SS_TYPE_CUSTOM && data->custom_data) {
         if (data->custom_cleanup) {
             data->custom_cleanup(data->custom_data);
         }
-        SS_FREE(data->custom_data);
+        SS_ACCT_FREE(SS_ALLOC_PAYLOADS, data->custom_data, data->size);
     }
 #endif
 
-    SS_FREE(data);
+    SS_ACCT_FREE(SS_ALLOC_PAYLOADS, data, sizeof(ss_data_t));
 }
 
 ss_error_t ss_data_set_int(ss_data_t* data, int value) {
@@ -741,12 +2093,12 @@ ss_error_t ss_data_set_string(ss_data_t* data, const char* value) {
     if (!data) return SS_ERR_NULL_PARAM;
     
     if (data->type == SS_TYPE_STRING && data->value.s_val) {
-        SS_FREE((void*)data->value.s_val);
+        SS_ACCT_FREE_STRING(SS_ALLOC_PAYLOADS, data->value.s_val);
     }
 
     data->type = SS_TYPE_STRING;
     if (value) {
-        data->value.s_val = SS_STRDUP(value);
+        data->value.s_val = SS_ACCT_STRDUP(SS_ALLOC_PAYLOADS, value);
         if (!data->value.s_val) return SS_ERR_MEMORY;
     } else {
         data->value.s_val = NULL;
@@ -770,11 +2122,11 @@ ss_error_t ss_data_set_custom(ss_data_t* data, void* value, size_t size,
         if (data->custom_cleanup) {
             data->custom_cleanup(data->custom_data);
         }
-        SS_FREE(data->custom_data);
+        SS_ACCT_FREE(SS_ALLOC_PAYLOADS, data->custom_data, data->size);
     }
 
     data->type = SS_TYPE_CUSTOM;
-    data->custom_data = SS_MALLOC(size);
+    data->custom_data = SS_ACCT_MALLOC(SS_ALLOC_PAYLOADS, size);
     if (!data->custom_data) return SS_ERR_MEMORY;
     data->custom_cleanup = cleanup;
     
@@ -784,86 +2136,591 @@ ss_error_t ss_data_set_custom(ss_data_t* data, void* value, size_t size,
 }
 #endif
 
-/* Data retrieval functions */
-int ss_data_get_int(const ss_data_t* data, int default_val) {
-    if (!data || data->type != SS_TYPE_INT) return default_val;
-    return data->value.i_val;
-}
+/* Data retrieval functions */
+int ss_data_get_int(const ss_data_t* data, int default_val) {
+    if (!data || data->type != SS_TYPE_INT) return default_val;
+    return data->value.i_val;
+}
+
+float ss_data_get_float(const ss_data_t* data, float default_val) {
+    if (!data || data->type != SS_TYPE_FLOAT) return default_val;
+    return data->value.f_val;
+}
+
+double ss_data_get_double(const ss_data_t* data, double default_val) {
+    if (!data || data->type != SS_TYPE_DOUBLE) return default_val;
+    return data->value.d_val;
+}
+
+const char* ss_data_get_string(const ss_data_t* data) {
+    if (!data || data->type != SS_TYPE_STRING) return NULL;
+    return data->value.s_val;
+}
+
+void* ss_data_get_pointer(const ss_data_t* data) {
+    if (!data || data->type != SS_TYPE_POINTER) return NULL;
+    return data->value.p_val;
+}
+
+#if SS_ENABLE_CUSTOM_DATA
+void* ss_data_get_custom(const ss_data_t* data, size_t* size) {
+    if (!data || data->type != SS_TYPE_CUSTOM) return NULL;
+    if (size) *size = data->size;
+    return data->custom_data;
+}
+#endif
+
+
+#if SS_ENABLE_MEMORY_STATS
+/* Fill stats from the context and allocation counters; caller holds the lock */
+static void memory_stats_snapshot(ss_memory_stats_t* stats) {
+    size_t i;
+
+    *stats = g_context->memory_stats;
+    for (i = 0; i < SS_ALLOC_COUNT; i++) {
+        ss_alloc_stats_t* c = &g_alloc.categories[i];
+        stats->categories[i].live_bytes = SS_ATOMIC_LOAD(&c->live_bytes);
+        stats->categories[i].peak_bytes = SS_ATOMIC_LOAD(&c->peak_bytes);
+        stats->categories[i].live_count = SS_ATOMIC_LOAD(&c->live_count);
+        stats->categories[i].total_count = SS_ATOMIC_LOAD(&c->total_count);
+    }
+#if SS_ENABLE_ALLOC_HISTOGRAM
+    for (i = 0; i < SS_ALLOC_SIZE_CLASSES; i++) {
+        stats->size_classes[i] = SS_ATOMIC_LOAD(&g_alloc.size_classes[i]);
+    }
+#else
+    memset(stats->size_classes, 0, sizeof(stats->size_classes));
+#endif
+
+#if SS_USE_STATIC_MEMORY
+    stats->signals_allocated = SS_MAX_SIGNALS;
+    stats->slots_allocated = SS_MAX_SLOTS;
+    stats->total_bytes_allocated = sizeof(ss_context_t);
+#else
+    stats->signals_allocated = stats->categories[SS_ALLOC_SIGNALS].live_count;
+    stats->slots_allocated = stats->categories[SS_ALLOC_SLOTS].live_count;
+    stats->total_bytes_allocated = SS_ATOMIC_LOAD(&g_alloc.live_bytes);
+#endif
+    stats->peak_bytes_allocated = SS_ATOMIC_LOAD(&g_alloc.peak_bytes);
+    stats->string_bytes = stats->categories[SS_ALLOC_NAMES].live_bytes;
+
+    stats->queue_bytes = sizeof(g_context->deferred_queue) +
+                         stats->categories[SS_ALLOC_QUEUES].live_bytes;
+#if SS_ENABLE_ISR_SAFE
+    stats->queue_bytes += sizeof(g_isr_queue);
+#endif
+}
+
+ss_error_t ss_get_memory_stats(ss_memory_stats_t* stats) {
+    if (!g_context || !stats) return SS_ERR_NULL_PARAM;
+    
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    memory_stats_snapshot(stats);
+    
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    
+    return SS_OK;
+}
+
+/* Restart peaks and counts; live usage is state, not a statistic */
+void ss_reset_memory_stats(void) {
+    size_t i;
+
+    if (!g_context) return;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    for (i = 0; i < SS_ALLOC_COUNT; i++) {
+        ss_alloc_stats_t* c = &g_alloc.categories[i];
+        c->peak_bytes = SS_ATOMIC_LOAD(&c->live_bytes);
+        c->total_count = 0;
+    }
+    g_alloc.peak_bytes = SS_ATOMIC_LOAD(&g_alloc.live_bytes);
+#if SS_ENABLE_ALLOC_HISTOGRAM
+    memset(g_alloc.size_classes, 0, sizeof(g_alloc.size_classes));
+#endif
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+}
+#endif
+
+#if SS_ENABLE_QUEUE_STATS
+/* Fill stats for one queue; caller holds the lock */
+static void queue_stats_snapshot(ss_queue_id_t queue, ss_queue_stats_t* stats) {
+    switch (queue) {
+        case SS_QUEUE_DEFERRED:
+            *stats = g_context->deferred_stats;
+            stats->capacity = SS_DEFERRED_QUEUE_SIZE;
+            stats->depth = g_context->deferred_count;
+            break;
+        case SS_QUEUE_ISR:
+#if SS_ENABLE_ISR_SAFE
+            *stats = g_isr_flush_stats;
+            stats->capacity = SS_ISR_QUEUE_SIZE;
+            stats->depth = (uint32_t)(g_isr_stats.enqueued - g_isr_stats.drained);
+            stats->high_water = g_isr_stats.high_water;
+            stats->enqueued = (uint32_t)(g_isr_stats.enqueued -
+                                         g_isr_stats.enqueued_base);
+            stats->dropped = (uint32_t)(g_isr_stats.dropped -
+                                        g_isr_stats.dropped_base);
+#else
+            memset(stats, 0, sizeof(ss_queue_stats_t));
+#endif
+            break;
+        default:
+            *stats = g_batch_stats;
+            stats->capacity = SS_BATCH_MAX_ENTRIES;
+            stats->depth = SS_ATOMIC_LOAD(&g_batch_stats.depth);
+            stats->high_water = SS_ATOMIC_LOAD(&g_batch_stats.high_water);
+            stats->enqueued = SS_ATOMIC_LOAD(&g_batch_stats.enqueued);
+            stats->dropped = SS_ATOMIC_LOAD(&g_batch_stats.dropped);
+            break;
+    }
+}
+
+ss_error_t ss_get_queue_stats(ss_queue_id_t queue, ss_queue_stats_t* stats) {
+    if (!g_context || !stats) return SS_ERR_NULL_PARAM;
+    if ((unsigned)queue >= SS_QUEUE_COUNT) return SS_ERR_INVALID_TYPE;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    queue_stats_snapshot(queue, stats);
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    return SS_OK;
+}
+
+/*
+ * Clear counters and histograms. Depth is live state and is kept; high-water
+ * marks restart from the current depth, or from zero for batches. ISR
+ * producer counters are rebased rather than cleared so the ISR remains
+ * their only writer.
+ */
+void ss_reset_queue_stats(void) {
+    size_t depth;
+
+    if (!g_context) return;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    memset(&g_context->deferred_stats, 0, sizeof(ss_queue_stats_t));
+    g_context->deferred_stats.high_water = g_context->deferred_count;
+
+#if SS_ENABLE_ISR_SAFE
+    memset(&g_isr_flush_stats, 0, sizeof(ss_queue_stats_t));
+    g_isr_stats.enqueued_base = g_isr_stats.enqueued;
+    g_isr_stats.dropped_base = g_isr_stats.dropped;
+    g_isr_stats.high_water = g_isr_stats.enqueued - g_isr_stats.drained;
+#endif
+
+    depth = SS_ATOMIC_LOAD(&g_batch_stats.depth);
+    memset(&g_batch_stats, 0, sizeof(ss_queue_stats_t));
+    g_batch_stats.depth = depth;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+}
+#endif
+
+#if SS_ENABLE_CALL_GRAPH
+ss_error_t ss_enable_call_graph(int enabled) {
+    if (!g_context) return SS_ERR_NULL_PARAM;
+    g_context->call_graph_enabled = enabled;
+    select_emit_path();
+    return SS_OK;
+}
+
+/* Name for a graph node; the root and unregistered signals are synthetic */
+static const char* call_graph_node(uint32_t id, char* scratch, size_t len) {
+    ss_signal_t* sig;
+    if (id == 0) return "(root)";
+    sig = find_signal_by_id(id);
+    if (sig) return sig->name;
+    snprintf(scratch, len, "#%lu", (unsigned long)id);
+    return scratch;
+}
+
+static void call_graph_dot(ss_writer_t* w) {
+    char parent_buf[16], child_buf[16];
+    size_t i;
+
+    writer_printf(w, "digraph ss_calls {\n");
+    writer_printf(w, "  \"(root)\" [shape=point];\n");
+    for (i = 0; i < SS_CALL_GRAPH_MAX_EDGES; i++) {
+        const ss_call_edge_t* e = &g_context->call_edges[i];
+        if (e->child_id == 0) continue;
+        writer_printf(w, "  ");
+        writer_quoted(w, call_graph_node(e->parent_id, parent_buf,
+                                         sizeof(parent_buf)), 0);
+        writer_printf(w, " -> ");
+        writer_quoted(w, call_graph_node(e->child_id, child_buf,
+                                         sizeof(child_buf)), 0);
+        writer_printf(w, " [label=\"%llu calls\\nincl %llu ns\\nexcl %llu ns\", "
+                      "weight=%llu];\n",
+                      (unsigned long long)e->count,
+                      (unsigned long long)e->inclusive_ns,
+                      (unsigned long long)e->exclusive_ns,
+                      (unsigned long long)e->count);
+    }
+    writer_printf(w, "}\n");
+}
+
+static void call_graph_json(ss_writer_t* w) {
+    char parent_buf[16], child_buf[16];
+    size_t i;
+    int first = 1;
+
+    writer_printf(w, "{\"edges\":[");
+    for (i = 0; i < SS_CALL_GRAPH_MAX_EDGES; i++) {
+        const ss_call_edge_t* e = &g_context->call_edges[i];
+        if (e->child_id == 0) continue;
+        writer_printf(w, "%s{\"parent\":", first ? "" : ",");
+        if (e->parent_id == 0) {
+            writer_printf(w, "null");
+        } else {
+            writer_quoted(w, call_graph_node(e->parent_id, parent_buf,
+                                             sizeof(parent_buf)), 0);
+        }
+        writer_printf(w, ",\"child\":");
+        writer_quoted(w, call_graph_node(e->child_id, child_buf,
+                                         sizeof(child_buf)), 0);
+        writer_printf(w, ",\"count\":%llu,\"inclusive_ns\":%llu,"
+                      "\"exclusive_ns\":%llu}",
+                      (unsigned long long)e->count,
+                      (unsigned long long)e->inclusive_ns,
+                      (unsigned long long)e->exclusive_ns);
+        first = 0;
+    }
+    writer_printf(w, "],\"dropped_edges\":%llu,\"truncated_depth\":%llu}\n",
+                  (unsigned long long)g_context->call_edges_dropped,
+                  (unsigned long long)g_context->call_depth_truncated);
+}
+
+ss_error_t ss_call_graph_write(char* buf, size_t len, ss_format_t format,
+                               size_t* written) {
+    ss_writer_t w = {0};
+
+    if (!g_context || (!buf && len > 0)) return SS_ERR_NULL_PARAM;
+    if (format != SS_FMT_DOT && format != SS_FMT_JSON) {
+        return SS_ERR_UNSUPPORTED;
+    }
+    w.buf = buf;
+    w.len = len;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    if (format == SS_FMT_DOT) {
+        call_graph_dot(&w);
+    } else {
+        call_graph_json(&w);
+    }
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    if (written) *written = w.pos;
+    if (w.failed) return SS_ERR_IO;
+    return w.pos < len ? SS_OK : SS_ERR_BUFFER_TOO_SMALL;
+}
+
+void ss_reset_call_graph(void) {
+    if (!g_context) return;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    memset(g_context->call_edges, 0, sizeof(g_context->call_edges));
+    g_context->call_edge_count = 0;
+    g_context->call_edges_dropped = 0;
+    g_context->call_depth_truncated = 0;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+}
+#endif
+
+#if SS_ENABLE_THREAD_STATS
+ss_error_t ss_enable_thread_stats(int enabled) {
+    if (!g_context) return SS_ERR_NULL_PARAM;
+    g_context->thread_stats_enabled = enabled;
+    select_emit_path();
+    return SS_OK;
+}
+
+/* Name the calling thread's block; fails once the pool is exhausted */
+ss_error_t ss_set_thread_name(const char* name) {
+    ss_thread_block_t* blk;
+
+    if (!name) return SS_ERR_NULL_PARAM;
+    blk = thread_block();
+    if (blk->b.shared) return SS_ERR_WOULD_OVERFLOW;
+    ss_strscpy(blk->b.stats.name, name, SS_THREAD_NAME_LENGTH);
+    return SS_OK;
+}
+
+/* Counters are read while their owners keep writing; totals may lag */
+ss_error_t ss_get_thread_stats(ss_thread_stats_t* out, size_t max, size_t* count) {
+    uint32_t epoch = SS_ATOMIC_LOAD(&g_thread_stats_epoch);
+    size_t used, i, n = 0;
+
+    if (!out || !count) return SS_ERR_NULL_PARAM;
+
+    used = SS_ATOMIC_LOAD(&g_thread_blocks_used);
+    if (used > SS_MAX_THREAD_STATS) used = SS_MAX_THREAD_STATS;
+    for (i = 0; i < used && n < max; i++) {
+        const ss_thread_block_t* blk = &g_thread_blocks[i];
+        ss_thread_stats_t* dst = &out[n];
+
+        if (SS_ATOMIC_LOAD(&blk->b.state) == SS_TBLOCK_UNUSED) continue;
+        n++;
+        memcpy(dst->name, blk->b.stats.name, SS_THREAD_NAME_LENGTH);
+        dst->name[SS_THREAD_NAME_LENGTH - 1] = '\0';
+        dst->thread_id = blk->b.stats.thread_id;
+        if (SS_ATOMIC_LOAD(&blk->b.epoch) != epoch) {
+            /* Reset since the owner last counted anything */
+            dst->emissions = dst->slot_calls = dst->dispatch_time_ns = 0;
+            dst->deferred_enqueues = dst->lock_waits = dst->lock_wait_ns = 0;
+            continue;
+        }
+        dst->emissions = SS_ATOMIC_LOAD(&blk->b.stats.emissions);
+        dst->slot_calls = SS_ATOMIC_LOAD(&blk->b.stats.slot_calls);
+        dst->dispatch_time_ns = SS_ATOMIC_LOAD(&blk->b.stats.dispatch_time_ns);
+        dst->deferred_enqueues = SS_ATOMIC_LOAD(&blk->b.stats.deferred_enqueues);
+        dst->lock_waits = SS_ATOMIC_LOAD(&blk->b.stats.lock_waits);
+        dst->lock_wait_ns = SS_ATOMIC_LOAD(&blk->b.stats.lock_wait_ns);
+    }
+    *count = n;
+    return SS_OK;
+}
+
+/* Zero the counters; threads keep their blocks and names. Each owner
+ * clears its own block on its next update, readers see zeros until then */
+void ss_reset_thread_stats(void) {
+    SS_ATOMIC_FETCH_ADD(&g_thread_stats_epoch, 1);
+}
+#endif
+
+#if SS_ENABLE_WASTE_STATS
+static void waste_stats_snapshot(const ss_signal_t* sig, ss_waste_stats_t* out) {
+    const ss_waste_counters_t* w = &sig->waste;
+
+    ss_strscpy(out->name, sig->name, SS_MAX_SIGNAL_NAME_LENGTH);
+    out->emissions = w->emissions;
+    out->zero_slot_emissions = w->zero_slot;
+    out->all_removed_emissions = w->all_removed;
+    out->wasted_emissions = w->zero_slot + w->all_removed;
+    out->slot_calls = w->slot_calls;
+    memcpy(out->fanout, w->fanout, sizeof(out->fanout));
+}
+
+ss_error_t ss_get_waste_stats(const char* signal_name, ss_waste_stats_t* stats) {
+    ss_signal_t* sig;
+
+    if (!g_context || !signal_name || !stats) return SS_ERR_NULL_PARAM;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    sig = find_signal(signal_name);
+    if (sig) waste_stats_snapshot(sig, stats);
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    return sig ? SS_OK : SS_ERR_NOT_FOUND;
+}
+
+/* Keep the `max` signals with the most wasted emissions, most first; an
+ * insertion sort keeps out ranked as the registry is walked */
+ss_error_t ss_get_waste_report(ss_waste_stats_t* out, size_t max, size_t* count) {
+    ss_signal_t* sig;
+    size_t n = 0;
+
+    if (!g_context || !out || !count) return SS_ERR_NULL_PARAM;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    for (sig = next_signal(NULL); sig; sig = next_signal(sig)) {
+        uint64_t wasted = sig->waste.zero_slot + sig->waste.all_removed;
+        size_t i;
+
+        if (wasted == 0 || max == 0) continue;
+        if (n == max && wasted <= out[n - 1].wasted_emissions) continue;
+
+        i = n < max ? n++ : n - 1;
+        while (i > 0 && out[i - 1].wasted_emissions < wasted) {
+            out[i] = out[i - 1];
+            i--;
+        }
+        waste_stats_snapshot(sig, &out[i]);
+    }
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    *count = n;
+    return SS_OK;
+}
+
+uint64_t ss_get_not_found_emissions(char* last_name, size_t len) {
+    uint64_t total;
+
+    if (!g_context) return 0;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    total = g_context->not_found_emissions;
+    if (last_name && len > 0) {
+        ss_strscpy(last_name, g_context->last_not_found, len);
+    }
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    return total;
+}
+
+void ss_reset_waste_stats(void) {
+    ss_signal_t* sig;
+
+    if (!g_context) return;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    for (sig = next_signal(NULL); sig; sig = next_signal(sig)) {
+        memset(&sig->waste, 0, sizeof(ss_waste_counters_t));
+    }
+    g_context->not_found_emissions = 0;
+    g_context->last_not_found[0] = '\0';
 
-float ss_data_get_float(const ss_data_t* data, float default_val) {
-    if (!data || data->type != SS_TYPE_FLOAT) return default_val;
-    return data->value.f_val;
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
 }
+#endif
 
-double ss_data_get_double(const ss_data_t* data, double default_val) {
-    if (!data || data->type != SS_TYPE_DOUBLE) return default_val;
-    return data->value.d_val;
-}
+#if SS_ENABLE_HOT_SIGNALS
+ss_error_t ss_enable_hot_signals(int enabled) {
+    if (!g_context) return SS_ERR_NULL_PARAM;
 
-const char* ss_data_get_string(const ss_data_t* data) {
-    if (!data || data->type != SS_TYPE_STRING) return NULL;
-    return data->value.s_val;
-}
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
 
-void* ss_data_get_pointer(const ss_data_t* data) {
-    if (!data || data->type != SS_TYPE_POINTER) return NULL;
-    return data->value.p_val;
-}
+    if (enabled && !g_context->hot_signals_enabled) {
+        g_context->hot_window_start = get_time_ns();
+    }
+    g_context->hot_signals_enabled = enabled;
+    select_emit_path();
 
-#if SS_ENABLE_CUSTOM_DATA
-void* ss_data_get_custom(const ss_data_t* data, size_t* size) {
-    if (!data || data->type != SS_TYPE_CUSTOM) return NULL;
-    if (size) *size = data->size;
-    return data->custom_data;
-}
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
 #endif
 
+    return SS_OK;
+}
+
+/* Rank the tracked signals by one metric and resolve their names */
+ss_error_t ss_get_hot_signals(ss_hot_metric_t metric, size_t k,
+                              ss_hot_signal_t* out, size_t* count) {
+    ss_hot_entry_t ranked[SS_HOT_SIGNALS_CAPACITY];
+    size_t i, j, n = 0;
+
+    if (!g_context || !out || !count) return SS_ERR_NULL_PARAM;
+    if (metric != SS_HOT_BY_EMISSIONS && metric != SS_HOT_BY_TIME) {
+        return SS_ERR_INVALID_TYPE;
+    }
 
-#if SS_ENABLE_MEMORY_STATS
-ss_error_t ss_get_memory_stats(ss_memory_stats_t* stats) {
-    if (!g_context || !stats) return SS_ERR_NULL_PARAM;
-    
 #if SS_ENABLE_THREAD_SAFETY
     if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
 #endif
 
-    
-    *stats = g_context->memory_stats;
-    
-#if SS_USE_STATIC_MEMORY
-    stats->signals_allocated = SS_MAX_SIGNALS;
-    stats->slots_allocated = SS_MAX_SLOTS;
-    stats->total_bytes_allocated = sizeof(ss_context_t);
-#else
-    /* Calculate dynamic memory usage */
-    stats->string_bytes = 0;
-    ss_signal_t* sig = g_context->signals;
-    while (sig) {
-        stats->string_bytes += strlen(sig->name) + 1;
-        if (sig->description) {
-            stats->string_bytes += strlen(sig->description) + 1;
+    memcpy(ranked, metric == SS_HOT_BY_EMISSIONS ? g_context->hot_by_count
+                                                 : g_context->hot_by_time,
+           sizeof(ranked));
+    for (i = 1; i < SS_HOT_SIGNALS_CAPACITY; i++) {
+        ss_hot_entry_t e = ranked[i];
+        for (j = i; j > 0 && ranked[j - 1].weight < e.weight; j--) {
+            ranked[j] = ranked[j - 1];
         }
-        sig = sig->next;
+        ranked[j] = e;
+    }
+
+    for (i = 0; i < SS_HOT_SIGNALS_CAPACITY && n < k; i++) {
+        const ss_hot_entry_t* e;
+        ss_signal_t* sig;
+
+        if (ranked[i].signal_id == 0 || ranked[i].weight == 0) continue;
+        sig = find_signal_by_id(ranked[i].signal_id);
+        if (!sig) continue;  /* Unregistered; ages out by decay */
+
+        memset(&out[n], 0, sizeof(ss_hot_signal_t));
+        ss_strscpy(out[n].name, sig->name, SS_MAX_SIGNAL_NAME_LENGTH);
+        out[n].signal_id = sig->id;
+        e = hot_table_find(g_context->hot_by_count, sig->id);
+        if (e) {
+            out[n].emissions = e->weight;
+            out[n].emissions_error = e->error;
+        }
+        e = hot_table_find(g_context->hot_by_time, sig->id);
+        if (e) {
+            out[n].time_ns = e->weight;
+            out[n].time_error_ns = e->error;
+        }
+        n++;
     }
-#endif
 
-    
 #if SS_ENABLE_THREAD_SAFETY
     if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
 #endif
 
-    
+    *count = n;
     return SS_OK;
 }
 
-void ss_reset_memory_stats(void) {
+void ss_reset_hot_signals(void) {
     if (!g_context) return;
 
 #if SS_ENABLE_THREAD_SAFETY
     if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
 #endif
 
-    memset(&g_context->memory_stats, 0, sizeof(ss_memory_stats_t));
+    memset(g_context->hot_by_count, 0, sizeof(g_context->hot_by_count));
+    memset(g_context->hot_by_time, 0, sizeof(g_context->hot_by_time));
+    g_context->hot_window_start = get_time_ns();
 
 #if SS_ENABLE_THREAD_SAFETY
     if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
@@ -871,7 +2728,6 @@ void ss_reset_memory_stats(void) {
 }
 #endif
 
-
 #if SS_ENABLE_PERFORMANCE_STATS
 ss_error_t ss_get_perf_stats(const char* signal_name, ss_perf_stats_t* stats) {
     ss_signal_t* sig;
@@ -892,7 +2748,7 @@ ss_error_t ss_get_perf_stats(const char* signal_name, ss_perf_stats_t* stats) {
         return SS_ERR_NOT_FOUND;
     }
     
-    *stats = sig->perf_stats;
+    perf_stats_snapshot(sig, stats);
     
 #if SS_ENABLE_THREAD_SAFETY
     if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
@@ -902,12 +2758,90 @@ ss_error_t ss_get_perf_stats(const char* signal_name, ss_perf_stats_t* stats) {
     return SS_OK;
 }
 
+ss_error_t ss_get_perf_histogram(const char* signal_name, ss_histogram_t* hist) {
+    ss_signal_t* sig;
+
+    if (!g_context || !signal_name || !hist) return SS_ERR_NULL_PARAM;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    sig = find_signal(signal_name);
+    if (sig) {
+        *hist = sig->latency_histogram;
+    }
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    return sig ? SS_OK : SS_ERR_NOT_FOUND;
+}
+
+ss_error_t ss_get_perf_percentiles(const char* signal_name,
+                                   const double* percentiles, size_t count,
+                                   uint64_t* out) {
+    ss_signal_t* sig;
+    size_t i;
+
+    if (!g_context || !signal_name || !percentiles || !out) {
+        return SS_ERR_NULL_PARAM;
+    }
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    sig = find_signal(signal_name);
+    if (sig) {
+        for (i = 0; i < count; i++) {
+            out[i] = ss_histogram_percentile(&sig->latency_histogram,
+                                             percentiles[i]);
+        }
+    }
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    return sig ? SS_OK : SS_ERR_NOT_FOUND;
+}
+
 ss_error_t ss_enable_profiling(int enabled) {
     if (!g_context) return SS_ERR_NULL_PARAM;
     g_context->profiling_enabled = enabled;
+    select_emit_path();
     return SS_OK;
 }
 
+ss_error_t ss_set_profiling_sample_rate(const char* signal_name,
+                                        uint32_t one_in_n) {
+    ss_signal_t* sig = NULL;
+    ss_error_t result = SS_OK;
+
+    if (!g_context) return SS_ERR_NULL_PARAM;
+
+    /* Emitters read both thresholds under the lock */
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    if (!signal_name) {
+        g_context->sample_threshold = sample_threshold_for(one_in_n);
+    } else if ((sig = find_signal(signal_name)) != NULL) {
+        sig->sample_threshold = one_in_n ? sample_threshold_for(one_in_n) : 0;
+    } else {
+        result = SS_ERR_NOT_FOUND;
+    }
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    return result;
+}
+
 void ss_reset_perf_stats(void) {
     if (!g_context) return;
 
@@ -921,6 +2855,7 @@ void ss_reset_perf_stats(void) {
         for (i = 0; i < SS_MAX_SIGNALS; i++) {
             if (g_context->signal_used[i]) {
                 memset(&g_context->signals[i].perf_stats, 0, sizeof(ss_perf_stats_t));
+                ss_histogram_reset(&g_context->signals[i].latency_histogram);
             }
         }
     }
@@ -929,6 +2864,7 @@ void ss_reset_perf_stats(void) {
         ss_signal_t* sig = g_context->signals;
         while (sig) {
             memset(&sig->perf_stats, 0, sizeof(ss_perf_stats_t));
+            ss_histogram_reset(&sig->latency_histogram);
             sig = sig->next;
         }
     }
@@ -961,10 +2897,99 @@ const char* ss_error_string(ss_error_t error) {
         case SS_ERR_TIMEOUT: return "Operation timed out";
         case SS_ERR_WOULD_OVERFLOW: return "Would overflow static buffer";
         case SS_ERR_ISR_UNSAFE: return "Operation not ISR-safe";
+        case SS_ERR_UNSUPPORTED: return "Not supported";
+        case SS_ERR_IO: return "Output write failed";
         default: return "Unknown error";
     }
 }
 
+#if SS_NEED_CLOCK
+ss_error_t ss_set_clock_source(ss_clock_source_t source) {
+    if (!g_context) return SS_ERR_NULL_PARAM;
+
+    switch (source) {
+        case SS_CLOCK_DEFAULT:
+            g_context->clock_func = default_clock();
+            break;
+        case SS_CLOCK_MONOTONIC:
+            g_context->clock_func = monotonic_clock;
+            break;
+        case SS_CLOCK_TSC:
+#if SS_ENABLE_TSC_CLOCK
+            if (tsc_calibrate()) {
+                g_context->clock_func = g_tsc.has_rdtscp ? tscp_clock : tsc_clock;
+                break;
+            }
+#endif
+            return SS_ERR_UNSUPPORTED;
+        default:
+            return SS_ERR_INVALID_TYPE;
+    }
+    g_context->clock_user_data = NULL;
+    return SS_OK;
+}
+
+/* User clock must return monotonic nanoseconds; NULL restores the default */
+ss_error_t ss_set_clock(ss_clock_func_t func, void* user_data) {
+    if (!g_context) return SS_ERR_NULL_PARAM;
+    if (!func) return ss_set_clock_source(SS_CLOCK_DEFAULT);
+    g_context->clock_func = func;
+    g_context->clock_user_data = user_data;
+    return SS_OK;
+}
+
+uint64_t ss_clock_now_ns(void) {
+    if (!g_context) return monotonic_clock(NULL);
+    return get_time_ns();
+}
+#endif
+
+#if SS_ENABLE_HOOKS
+static void update_hooks_active(void) {
+    g_context->hooks_active = g_context->emit_pre_hook || g_context->emit_post_hook ||
+                              g_context->slot_pre_hook || g_context->slot_post_hook;
+    select_emit_path();
+}
+
+ss_error_t ss_set_emit_hooks(ss_hook_func_t pre, ss_hook_func_t post, void* ctx) {
+    if (!g_context) return SS_ERR_NULL_PARAM;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    g_context->emit_pre_hook = pre;
+    g_context->emit_post_hook = post;
+    g_context->emit_hook_ctx = ctx;
+    update_hooks_active();
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    return SS_OK;
+}
+
+ss_error_t ss_set_slot_hooks(ss_hook_func_t pre, ss_hook_func_t post, void* ctx) {
+    if (!g_context) return SS_ERR_NULL_PARAM;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    g_context->slot_pre_hook = pre;
+    g_context->slot_post_hook = post;
+    g_context->slot_hook_ctx = ctx;
+    update_hooks_active();
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    return SS_OK;
+}
+#endif
+
 #if SS_ENABLE_DEBUG_TRACE
 void ss_enable_trace(FILE* output) {
     if (g_context) {
@@ -979,6 +3004,190 @@ void ss_disable_trace(void) {
 }
 #endif
 
+#if SS_ENABLE_TRACE_BUFFER
+ss_error_t ss_trace_buffer_start(void) {
+    if (!g_context) return SS_ERR_NULL_PARAM;
+    g_context->trace_recording = 1;
+    select_emit_path();
+    return SS_OK;
+}
+
+void ss_trace_buffer_stop(void) {
+    if (g_context) {
+        g_context->trace_recording = 0;
+        select_emit_path();
+    }
+}
+
+void ss_trace_buffer_clear(void) {
+    if (!g_context) return;
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+    g_context->trace_head = 0;
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+}
+
+/* Chrome timestamps are microseconds; keep nanosecond precision */
+static void trace_write_event_head(ss_writer_t* w, const ss_trace_record_t* rec,
+                                   const char* cat, const char* ph,
+                                   uint64_t ts_ns) {
+    writer_printf(w, "{\"cat\":\"%s\",\"ph\":\"%s\",\"ts\":%llu.%03u,"
+                  "\"pid\":1,\"tid\":%lu,\"name\":",
+                  cat, ph, (unsigned long long)(ts_ns / 1000),
+                  (unsigned)(ts_ns % 1000), (unsigned long)rec->thread_id);
+}
+
+/* Slice name for a B/E record: the signal, or the slot's address */
+static void trace_write_slice(ss_writer_t* w, const ss_trace_record_t* rec,
+                              const char* ph, uint64_t ts) {
+    char slot_name[32];
+
+    if (rec->type == SS_TREC_EMIT_BEGIN || rec->type == SS_TREC_EMIT_END) {
+        trace_write_event_head(w, rec, "emit", ph, ts);
+        writer_quoted(w, rec->name, 0);
+        writer_printf(w, "}");
+        return;
+    }
+    snprintf(slot_name, sizeof(slot_name), "slot 0x%llx",
+             (unsigned long long)(uintptr_t)rec->slot);
+    trace_write_event_head(w, rec, "slot", ph, ts);
+    writer_quoted(w, slot_name, 0);
+    writer_printf(w, ",\"args\":{\"signal\":");
+    writer_quoted(w, rec->name, 0);
+    writer_printf(w, "}}");
+}
+
+/* Deferred enqueue or dispatch: a short slice holding one flow endpoint */
+static void trace_write_flow(ss_writer_t* w, const ss_trace_record_t* rec,
+                             uint64_t ts) {
+    int start = rec->type == SS_TREC_DEFER;
+
+    trace_write_event_head(w, rec, "deferred", "B", ts);
+    writer_quoted(w, rec->name, 0);
+    writer_printf(w, "},");
+    trace_write_event_head(w, rec, "deferred", start ? "s" : "f", ts);
+    /* bp:e binds the flow end to this enclosing slice, not the next one */
+    writer_printf(w, start ? "\"deferred\",\"id\":%llu}," :
+                  "\"deferred\",\"id\":%llu,\"bp\":\"e\"},",
+                  (unsigned long long)rec->flow_id);
+    trace_write_event_head(w, rec, "deferred", "E", ts + 1);
+    writer_quoted(w, rec->name, 0);
+    writer_printf(w, "}");
+}
+
+static int trace_opens(const ss_trace_record_t* rec) {
+    return rec->type == SS_TREC_EMIT_BEGIN || rec->type == SS_TREC_SLOT_BEGIN;
+}
+
+static int trace_closes(const ss_trace_record_t* rec) {
+    return rec->type == SS_TREC_EMIT_END || rec->type == SS_TREC_SLOT_END;
+}
+
+/*
+ * Convert the binary trace buffer to Chrome Trace Event JSON. Emissions and
+ * slot invocations become nested B/E slices per thread; deferred emissions
+ * become flow arrows from the enqueue slice to the dispatch slice. Runs
+ * under the context lock, so recording may continue on other threads.
+ *
+ * Events are written one thread at a time, which keeps the slice depth to
+ * one counter without per-thread state. Once the ring has wrapped, a
+ * thread's oldest records may be ends whose begins were overwritten; they
+ * are skipped. Slices still open at the end (emissions in progress, or
+ * recording stopped mid-emission) are closed at the last timestamp.
+ */
+ss_error_t ss_trace_export_chrome(FILE* output) {
+    ss_writer_t w = {0};
+    uint64_t head, first, i, j, base_ns, end_ns;
+    uint32_t tid, next_tid;
+    size_t depth, skip;
+    int any = 0;
+
+    if (!g_context || !output) return SS_ERR_NULL_PARAM;
+    w.file = output;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    head = g_context->trace_head;
+    first = head > SS_TRACE_BUFFER_SIZE ? head - SS_TRACE_BUFFER_SIZE : 0;
+    base_ns = head > first ?
+        g_context->trace_records[first & (SS_TRACE_BUFFER_SIZE - 1)].timestamp_ns : 0;
+    end_ns = head > first ?
+        g_context->trace_records[(head - 1) & (SS_TRACE_BUFFER_SIZE - 1)].timestamp_ns -
+        base_ns : 0;
+
+    writer_printf(&w, "{\"traceEvents\":[");
+    for (tid = 0; head > first; tid = next_tid + 1) {
+        /* Lowest thread id not yet written */
+        next_tid = UINT32_MAX;
+        for (i = first; i < head; i++) {
+            uint32_t t =
+                g_context->trace_records[i & (SS_TRACE_BUFFER_SIZE - 1)].thread_id;
+            if (t >= tid && t < next_tid) next_tid = t;
+        }
+        if (next_tid == UINT32_MAX) break;
+
+        depth = 0;
+        for (i = first; i < head; i++) {
+            const ss_trace_record_t* rec =
+                &g_context->trace_records[i & (SS_TRACE_BUFFER_SIZE - 1)];
+            uint64_t ts = rec->timestamp_ns - base_ns;
+
+            if (rec->thread_id != next_tid) continue;
+            if (trace_closes(rec) && depth == 0) continue;   /* Begin lost */
+
+            if (any) writer_printf(&w, ",");
+            any = 1;
+            if (trace_opens(rec)) {
+                trace_write_slice(&w, rec, "B", ts);
+                depth++;
+            } else if (trace_closes(rec)) {
+                trace_write_slice(&w, rec, "E", ts);
+                depth--;
+            } else if (rec->type == SS_TREC_DEFER ||
+                       rec->type == SS_TREC_DEFER_FLUSH) {
+                trace_write_flow(&w, rec, ts);
+            } else {
+                writer_printf(&w, "{}");
+            }
+        }
+
+        /* Close open slices innermost first, matching ends from the back */
+        skip = 0;
+        for (j = head; depth > 0 && j > first; j--) {
+            const ss_trace_record_t* rec =
+                &g_context->trace_records[(j - 1) & (SS_TRACE_BUFFER_SIZE - 1)];
+
+            if (rec->thread_id != next_tid) continue;
+            if (trace_closes(rec)) {
+                skip++;
+            } else if (trace_opens(rec)) {
+                if (skip > 0) {
+                    skip--;
+                    continue;
+                }
+                writer_printf(&w, ",");
+                trace_write_slice(&w, rec, "E", end_ns);
+                depth--;
+            }
+        }
+    }
+    writer_printf(&w, "],\"displayTimeUnit\":\"ns\","
+                  "\"otherData\":{\"dropped_records\":%llu}}\n",
+                  (unsigned long long)first);
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    return (w.failed || ferror(output)) ? SS_ERR_IO : SS_OK;
+}
+#endif
+
 /* Signal existence check */
 int ss_signal_exists(const char* signal_name) {
     if (!g_context || !signal_name) return 0;
@@ -1027,7 +3236,7 @@ ss_error_t ss_disconnect_handle(ss_connection_t handle) {
                         sig->slots = curr->next;
                     }
                     sig->slot_count--;
-                    free_slot(curr);
+                    release_slot(curr);
                 }
                 result = SS_OK;
                 goto done;
@@ -1052,8 +3261,8 @@ ss_error_t ss_disconnect_handle(ss_connection_t handle) {
                     } else {
                         sig->slots = curr->next;
                     }
-                    SS_FREE(curr);
                     sig->slot_count--;
+                    release_slot(curr);
                 }
                 result = SS_OK;
                 goto done;
@@ -1097,21 +3306,12 @@ ss_error_t ss_disconnect_all(const char* signal_name) {
             curr = curr->next;
         }
     } else {
-#if SS_USE_STATIC_MEMORY
-        ss_slot_t* curr = sig->slots;
-        while (curr) {
-            ss_slot_t* next = curr->next;
-            free_slot(curr);
-            curr = next;
-        }
-#else
         ss_slot_t* curr = sig->slots;
         while (curr) {
             ss_slot_t* next = curr->next;
-            SS_FREE(curr);
+            release_slot(curr);
             curr = next;
         }
-#endif
         sig->slots = NULL;
         sig->slot_count = 0;
     }
@@ -1153,11 +3353,7 @@ ss_error_t ss_disconnect(const char* signal_name, ss_slot_func_t slot) {
                     sig->slots = curr->next;
                 }
                 sig->slot_count--;
-#if SS_USE_STATIC_MEMORY
-                free_slot(curr);
-#else
-                SS_FREE(curr);
-#endif
+                release_slot(curr);
             }
 
 #if SS_ENABLE_THREAD_SAFETY
@@ -1183,39 +3379,22 @@ ss_error_t ss_signal_unregister(const char* signal_name) {
 #if SS_ENABLE_THREAD_SAFETY
     if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
 #endif
-    
-    ss_signal_t* sig = find_signal(signal_name);
-    if (!sig) {
-#if SS_ENABLE_THREAD_SAFETY
-        if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
-#endif
-        return SS_ERR_NOT_FOUND;
-    }
-    
-    /* First disconnect all slots - do it inline to avoid deadlock */
-#if SS_USE_STATIC_MEMORY
-    /* Mark all slots as unused in static allocation */
-    ss_slot_t* curr = sig->slots;
-    while (curr) {
-        size_t i;
-        for (i = 0; i < SS_MAX_SLOTS; i++) {
-            if (&g_context->slots[i] == curr) {
-                g_context->slot_used[i] = 0;
-                g_context->slot_count--;
-                break;
-            }
-        }
-        curr = curr->next;
+    
+    ss_signal_t* sig = find_signal(signal_name);
+    if (!sig) {
+#if SS_ENABLE_THREAD_SAFETY
+        if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+        return SS_ERR_NOT_FOUND;
     }
-#else
-    /* Free all slots for dynamic memory */
+    
+    /* First disconnect all slots - do it inline to avoid deadlock */
     ss_slot_t* curr = sig->slots;
     while (curr) {
         ss_slot_t* next = curr->next;
-        SS_FREE(curr);
+        release_slot(curr);
         curr = next;
     }
-#endif
     
     sig->slots = NULL;
     sig->slot_count = 0;
@@ -1225,27 +3404,41 @@ ss_error_t ss_signal_unregister(const char* signal_name) {
     size_t i;
     for (i = 0; i < SS_MAX_SIGNALS; i++) {
         if (&g_context->signals[i] == sig) {
+            if (sig->description) {
+                SS_ACCT_FREE_STRING(SS_ALLOC_NAMES, sig->description);
+                sig->description = NULL;
+            }
             g_context->signal_used[i] = 0;
             g_context->signal_count--;
+#if SS_ENABLE_MEMORY_STATS
+            alloc_release(SS_ALLOC_SIGNALS, sizeof(ss_signal_t));
+#endif
             break;
         }
     }
 #else
     /* Remove from linked list in dynamic allocation */
-    if (sig->name) SS_FREE(sig->name);
-    if (sig->description) SS_FREE(sig->description);
+    if (sig->name) SS_ACCT_FREE_STRING(SS_ALLOC_NAMES, sig->name);
+    if (sig->description) SS_ACCT_FREE_STRING(SS_ALLOC_NAMES, sig->description);
     
     ss_signal_t** sig_curr = &g_context->signals;
     while (*sig_curr) {
         if (*sig_curr == sig) {
             *sig_curr = sig->next;
-            SS_FREE(sig);
+            SS_ACCT_FREE(SS_ALLOC_SIGNALS, sig, sizeof(ss_signal_t));
             g_context->signal_count--;
+#if SS_ENABLE_INTROSPECTION
+            g_registry_generation++;
+#endif
             break;
         }
         sig_curr = &(*sig_curr)->next;
     }
 #endif
+
+#if SS_ENABLE_MEMORY_STATS
+    g_context->memory_stats.signals_used = g_context->signal_count;
+#endif
     
 #if SS_ENABLE_THREAD_SAFETY
     if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
@@ -1278,7 +3471,8 @@ ss_error_t ss_get_signal_list(ss_signal_info_t** list, size_t* count) {
         return SS_OK;
     }
     
-    *list = (ss_signal_info_t*)SS_CALLOC(*count, sizeof(ss_signal_info_t));
+    *list = (ss_signal_info_t*)SS_ACCT_CALLOC(SS_ALLOC_OTHER, *count,
+                                              sizeof(ss_signal_info_t));
     if (!*list) {
 #if SS_ENABLE_THREAD_SAFETY
         if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
@@ -1291,7 +3485,8 @@ ss_error_t ss_get_signal_list(ss_signal_info_t** list, size_t* count) {
     size_t i;
     for (i = 0; i < SS_MAX_SIGNALS && idx < *count; i++) {
         if (g_context->signal_used[i]) {
-            (*list)[idx].name = SS_STRDUP(g_context->signals[i].name);
+            (*list)[idx].name = SS_ACCT_STRDUP(SS_ALLOC_OTHER,
+                                               g_context->signals[i].name);
             (*list)[idx].description = g_context->signals[i].description;
             (*list)[idx].slot_count = g_context->signals[i].slot_count;
             (*list)[idx].priority = g_context->signals[i].priority;
@@ -1301,7 +3496,7 @@ ss_error_t ss_get_signal_list(ss_signal_info_t** list, size_t* count) {
 #else
     ss_signal_t* sig = g_context->signals;
     while (sig && idx < *count) {
-        (*list)[idx].name = SS_STRDUP(sig->name);
+        (*list)[idx].name = SS_ACCT_STRDUP(SS_ALLOC_OTHER, sig->name);
         (*list)[idx].description = sig->description;
         (*list)[idx].slot_count = sig->slot_count;
         (*list)[idx].priority = sig->priority;
@@ -1322,10 +3517,434 @@ void ss_free_signal_list(ss_signal_info_t* list, size_t count) {
     if (list) {
         size_t i;
         for (i = 0; i < count; i++) {
-            if (list[i].name) SS_FREE(list[i].name);
+            if (list[i].name) SS_ACCT_FREE_STRING(SS_ALLOC_OTHER, list[i].name);
+        }
+        SS_ACCT_FREE(SS_ALLOC_OTHER, list, count * sizeof(ss_signal_info_t));
+    }
+}
+
+static void fill_signal_view(const ss_signal_t* sig, ss_signal_view_t* view) {
+    view->name = sig->name;
+    view->description = sig->description;
+    view->id = sig->id;
+    view->slot_count = sig->slot_count;
+    view->priority = sig->priority;
+#if SS_ENABLE_PERFORMANCE_STATS
+    perf_stats_snapshot(sig, &view->perf_stats);
+#else
+    memset(&view->perf_stats, 0, sizeof(view->perf_stats));
+#endif
+}
+
+/* Views are only valid during the callback, which runs with the lock held */
+ss_error_t ss_foreach_signal(ss_signal_visit_func_t visit, void* ctx) {
+    ss_signal_view_t view;
+    ss_signal_t* sig;
+
+    if (!g_context || !visit) return SS_ERR_NULL_PARAM;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    for (sig = next_signal(NULL); sig; sig = next_signal(sig)) {
+        fill_signal_view(sig, &view);
+        if (visit(&view, ctx)) break;
+    }
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    return SS_OK;
+}
+
+ss_error_t ss_foreach_slot(const char* signal_name, ss_slot_visit_func_t visit,
+                           void* ctx) {
+    ss_slot_view_t view;
+    ss_signal_t* sig;
+    ss_slot_t* slot;
+
+    if (!g_context || !signal_name || !visit) return SS_ERR_NULL_PARAM;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    sig = find_signal(signal_name);
+    if (!sig) {
+#if SS_ENABLE_THREAD_SAFETY
+        if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+        return SS_ERR_NOT_FOUND;
+    }
+
+    /* Slots disconnected mid-emission stay linked until the sweep */
+    for (slot = sig->slots; slot; slot = slot->next) {
+        if (slot->removed) continue;
+        view.handle = slot->handle;
+        view.func = slot->func;
+        view.user_data = slot->user_data;
+        view.priority = slot->priority;
+        if (visit(&view, ctx)) break;
+    }
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    return SS_OK;
+}
+
+void ss_signal_iter_init(ss_signal_iter_t* it) {
+    if (it) memset(it, 0, sizeof(*it));
+}
+
+/*
+ * Static entries never move, so the saved position is always usable. In
+ * dynamic mode the list is newest first with ids strictly decreasing: if
+ * the registry changed since the last call, resume at the first signal
+ * older than the last one returned instead of trusting the pointer.
+ */
+static ss_signal_t* signal_iter_advance(ss_signal_iter_t* it) {
+    if (it->last_id == 0) return next_signal(NULL);
+#if SS_USE_STATIC_MEMORY
+    return next_signal((ss_signal_t*)it->pos);
+#else
+    ss_signal_t* sig;
+
+    if (it->generation == g_registry_generation) {
+        return next_signal((ss_signal_t*)it->pos);
+    }
+    for (sig = next_signal(NULL); sig; sig = next_signal(sig)) {
+        if (sig->id < it->last_id) return sig;
+    }
+    return NULL;
+#endif
+}
+
+ss_error_t ss_signal_iter_next(ss_signal_iter_t* it, ss_signal_view_t* view) {
+    ss_signal_t* sig;
+
+    if (!g_context || !it || !view) return SS_ERR_NULL_PARAM;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    sig = signal_iter_advance(it);
+    if (sig) {
+        fill_signal_view(sig, view);
+        /* The name must outlive the lock; the description cannot */
+        ss_strscpy(it->name, sig->name, sizeof(it->name));
+        view->name = it->name;
+        view->description = NULL;
+        it->pos = sig;
+        it->last_id = sig->id;
+#if !SS_USE_STATIC_MEMORY
+        it->generation = g_registry_generation;
+#endif
+    }
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    return sig ? SS_OK : SS_ERR_NOT_FOUND;
+}
+
+/* Prometheus family header */
+static void metrics_family(ss_writer_t* w, const char* name, const char* type,
+                           const char* help) {
+    writer_printf(w, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+static void metrics_signal_sample(ss_writer_t* w, const char* name,
+                                  const ss_signal_t* sig, unsigned long long v) {
+    writer_printf(w, "%s{signal=", name);
+    writer_quoted(w, sig->name, 1);
+    writer_printf(w, "} %llu\n", v);
+}
+
+#if SS_NEED_HISTOGRAM
+/*
+ * One histogram series. Every bucket is written, empty or not, so each
+ * scrape has the same boundaries. The last bucket also holds values
+ * clamped from above the tracked range, so it is only counted in +Inf.
+ */
+static void metrics_histogram(ss_writer_t* w, const char* name,
+                              const char* label, const char* value,
+                              const ss_histogram_t* hist, uint64_t sum) {
+    unsigned long long cumulative = 0;
+    size_t b;
+
+    for (b = 0; b < SS_PERF_HISTOGRAM_BUCKETS - 1; b++) {
+        cumulative += hist->counts[b];
+        writer_printf(w, "%s_bucket{%s=", name, label);
+        writer_quoted(w, value, 1);
+        writer_printf(w, ",le=\"%llu\"} %llu\n",
+                      (unsigned long long)histogram_bucket_upper(b), cumulative);
+    }
+    cumulative += hist->counts[b];
+    writer_printf(w, "%s_bucket{%s=", name, label);
+    writer_quoted(w, value, 1);
+    writer_printf(w, ",le=\"+Inf\"} %llu\n%s_sum{%s=", cumulative, name, label);
+    writer_quoted(w, value, 1);
+    writer_printf(w, "} %llu\n%s_count{%s=", (unsigned long long)sum, name, label);
+    writer_quoted(w, value, 1);
+    writer_printf(w, "} %llu\n", cumulative);
+}
+#endif
+
+#if SS_ENABLE_QUEUE_STATS
+static const char* const g_queue_names[SS_QUEUE_COUNT] = {
+    "deferred", "isr", "batch"
+};
+#endif
+
+static void metrics_prometheus(ss_writer_t* w) {
+    ss_signal_t* sig;
+#if SS_ENABLE_PERFORMANCE_STATS
+    ss_perf_stats_t perf;
+#endif
+#if SS_ENABLE_MEMORY_STATS
+    ss_memory_stats_t mem;
+#endif
+
+    metrics_family(w, "ss_signals", "gauge", "Registered signals");
+    writer_printf(w, "ss_signals %lu\n", (unsigned long)g_context->signal_count);
+
+    metrics_family(w, "ss_signal_slots", "gauge", "Connected slots per signal");
+    for (sig = next_signal(NULL); sig; sig = next_signal(sig)) {
+        metrics_signal_sample(w, "ss_signal_slots", sig, sig->slot_count);
+    }
+
+#if SS_ENABLE_PERFORMANCE_STATS
+    metrics_family(w, "ss_signal_emissions_total", "counter",
+                   "Emissions per signal while profiling");
+    for (sig = next_signal(NULL); sig; sig = next_signal(sig)) {
+        metrics_signal_sample(w, "ss_signal_emissions_total", sig,
+                              sig->perf_stats.total_emissions);
+    }
+
+    metrics_family(w, "ss_signal_time_ns_total", "counter",
+                   "Estimated dispatch time per signal");
+    for (sig = next_signal(NULL); sig; sig = next_signal(sig)) {
+        perf_stats_snapshot(sig, &perf);
+        metrics_signal_sample(w, "ss_signal_time_ns_total", sig,
+                              perf.total_time_ns);
+    }
+
+    metrics_family(w, "ss_signal_latency_ns", "histogram",
+                   "Sampled emission latency");
+    for (sig = next_signal(NULL); sig; sig = next_signal(sig)) {
+        metrics_histogram(w, "ss_signal_latency_ns", "signal", sig->name,
+                          &sig->latency_histogram,
+                          sig->perf_stats.sampled_time_ns);
+    }
+#endif
+
+#if SS_ENABLE_QUEUE_STATS
+    {
+        ss_queue_stats_t qs[SS_QUEUE_COUNT];
+        int q;
+
+        for (q = 0; q < SS_QUEUE_COUNT; q++) {
+            queue_stats_snapshot((ss_queue_id_t)q, &qs[q]);
+        }
+
+#define SS_METRICS_QUEUE_SERIES(name, type, help, field)                     \
+        do {                                                                 \
+            metrics_family(w, name, type, help);                             \
+            for (q = 0; q < SS_QUEUE_COUNT; q++) {                           \
+                writer_printf(w, name "{queue=\"%s\"} %llu\n",                \
+                              g_queue_names[q],                              \
+                              (unsigned long long)qs[q].field);              \
+            }                                                                \
+        } while (0)
+
+        SS_METRICS_QUEUE_SERIES("ss_queue_depth", "gauge",
+                                "Entries waiting in a queue", depth);
+        SS_METRICS_QUEUE_SERIES("ss_queue_capacity", "gauge",
+                                "Queue capacity", capacity);
+        SS_METRICS_QUEUE_SERIES("ss_queue_high_water", "gauge",
+                                "Deepest the queue has been", high_water);
+        SS_METRICS_QUEUE_SERIES("ss_queue_enqueued_total", "counter",
+                                "Entries accepted", enqueued);
+        SS_METRICS_QUEUE_SERIES("ss_queue_dropped_total", "counter",
+                                "Entries rejected when full", dropped);
+        SS_METRICS_QUEUE_SERIES("ss_queue_flushes_total", "counter",
+                                "Flushes that dispatched entries", flushes);
+        SS_METRICS_QUEUE_SERIES("ss_queue_flushed_total", "counter",
+                                "Entries dispatched by flushes", flushed);
+#undef SS_METRICS_QUEUE_SERIES
+
+        metrics_family(w, "ss_queue_flush_duration_ns", "histogram",
+                       "Time to dispatch a flushed queue");
+        for (q = 0; q < SS_QUEUE_COUNT; q++) {
+            metrics_histogram(w, "ss_queue_flush_duration_ns", "queue",
+                              g_queue_names[q], &qs[q].flush_histogram,
+                              qs[q].flush_time_ns);
+        }
+    }
+#else
+    metrics_family(w, "ss_queue_depth", "gauge", "Entries waiting in a queue");
+    writer_printf(w, "ss_queue_depth{queue=\"deferred\"} %lu\n",
+                  (unsigned long)g_context->deferred_count);
+    metrics_family(w, "ss_queue_capacity", "gauge", "Queue capacity");
+    writer_printf(w, "ss_queue_capacity{queue=\"deferred\"} %lu\n",
+                  (unsigned long)SS_DEFERRED_QUEUE_SIZE);
+#endif
+
+#if SS_ENABLE_MEMORY_STATS
+    memory_stats_snapshot(&mem);
+    metrics_family(w, "ss_memory_signals", "gauge", "Signals used and allocated");
+    writer_printf(w, "ss_memory_signals{state=\"used\"} %lu\n"
+                  "ss_memory_signals{state=\"allocated\"} %lu\n",
+                  (unsigned long)mem.signals_used,
+                  (unsigned long)mem.signals_allocated);
+    metrics_family(w, "ss_memory_slots", "gauge", "Slots used and allocated");
+    writer_printf(w, "ss_memory_slots{state=\"used\"} %lu\n"
+                  "ss_memory_slots{state=\"allocated\"} %lu\n",
+                  (unsigned long)mem.slots_used,
+                  (unsigned long)mem.slots_allocated);
+    metrics_family(w, "ss_memory_bytes", "gauge", "Library memory in bytes");
+    writer_printf(w, "ss_memory_bytes{kind=\"total\"} %lu\n"
+                  "ss_memory_bytes{kind=\"peak\"} %lu\n"
+                  "ss_memory_bytes{kind=\"strings\"} %lu\n"
+                  "ss_memory_bytes{kind=\"queues\"} %lu\n",
+                  (unsigned long)mem.total_bytes_allocated,
+                  (unsigned long)mem.peak_bytes_allocated,
+                  (unsigned long)mem.string_bytes,
+                  (unsigned long)mem.queue_bytes);
+#endif
+}
+
+static void metrics_json(ss_writer_t* w) {
+    ss_signal_t* sig;
+    int first = 1;
+#if SS_ENABLE_PERFORMANCE_STATS
+    ss_perf_stats_t perf;
+    size_t b;
+#endif
+#if SS_ENABLE_MEMORY_STATS
+    ss_memory_stats_t mem;
+#endif
+
+    writer_printf(w, "{\"signals\":[");
+    for (sig = next_signal(NULL); sig; sig = next_signal(sig)) {
+        writer_printf(w, "%s{\"name\":", first ? "" : ",");
+        first = 0;
+        writer_quoted(w, sig->name, 0);
+        writer_printf(w, ",\"slots\":%lu,\"priority\":%d",
+                      (unsigned long)sig->slot_count, (int)sig->priority);
+#if SS_ENABLE_PERFORMANCE_STATS
+        perf_stats_snapshot(sig, &perf);
+        writer_printf(w, ",\"emissions\":%llu,\"sampled_emissions\":%llu,"
+                      "\"total_time_ns\":%llu,\"avg_time_ns\":%llu,"
+                      "\"min_time_ns\":%llu,\"max_time_ns\":%llu,"
+                      "\"latency_buckets\":[",
+                      (unsigned long long)perf.total_emissions,
+                      (unsigned long long)perf.sampled_emissions,
+                      (unsigned long long)perf.total_time_ns,
+                      (unsigned long long)perf.avg_time_ns,
+                      (unsigned long long)perf.min_time_ns,
+                      (unsigned long long)perf.max_time_ns);
+        {
+            int first_bucket = 1;
+            for (b = 0; b < SS_PERF_HISTOGRAM_BUCKETS; b++) {
+                if (!sig->latency_histogram.counts[b]) continue;
+                writer_printf(w, "%s[%llu,%llu]", first_bucket ? "" : ",",
+                              (unsigned long long)histogram_bucket_upper(b),
+                              (unsigned long long)sig->latency_histogram.counts[b]);
+                first_bucket = 0;
+            }
         }
-        SS_FREE(list);
+        writer_printf(w, "]");
+#endif
+        writer_printf(w, "}");
+    }
+#if SS_ENABLE_QUEUE_STATS
+    writer_printf(w, "],\"queues\":{");
+    {
+        ss_queue_stats_t qs;
+        int q;
+        for (q = 0; q < SS_QUEUE_COUNT; q++) {
+            queue_stats_snapshot((ss_queue_id_t)q, &qs);
+            writer_printf(w, "%s\"%s\":{\"depth\":%lu,\"capacity\":%lu,"
+                          "\"high_water\":%lu,\"enqueued\":%llu,"
+                          "\"dropped\":%llu,\"flushes\":%llu,\"flushed\":%llu,"
+                          "\"flush_time_ns\":%llu,\"flush_p99_ns\":%llu}",
+                          q ? "," : "", g_queue_names[q],
+                          (unsigned long)qs.depth, (unsigned long)qs.capacity,
+                          (unsigned long)qs.high_water,
+                          (unsigned long long)qs.enqueued,
+                          (unsigned long long)qs.dropped,
+                          (unsigned long long)qs.flushes,
+                          (unsigned long long)qs.flushed,
+                          (unsigned long long)qs.flush_time_ns,
+                          (unsigned long long)ss_histogram_percentile(
+                              &qs.flush_histogram, 99.0));
+        }
+    }
+    writer_printf(w, "}");
+#else
+    writer_printf(w, "],\"queues\":{\"deferred\":{\"depth\":%lu,\"capacity\":%lu}}",
+                  (unsigned long)g_context->deferred_count,
+                  (unsigned long)SS_DEFERRED_QUEUE_SIZE);
+#endif
+
+#if SS_ENABLE_MEMORY_STATS
+    memory_stats_snapshot(&mem);
+    writer_printf(w, ",\"memory\":{\"signals_used\":%lu,\"signals_allocated\":%lu,"
+                  "\"slots_used\":%lu,\"slots_allocated\":%lu,"
+                  "\"total_bytes_allocated\":%lu,\"peak_bytes_allocated\":%lu,"
+                  "\"string_bytes\":%lu,\"queue_bytes\":%lu}",
+                  (unsigned long)mem.signals_used,
+                  (unsigned long)mem.signals_allocated,
+                  (unsigned long)mem.slots_used,
+                  (unsigned long)mem.slots_allocated,
+                  (unsigned long)mem.total_bytes_allocated,
+                  (unsigned long)mem.peak_bytes_allocated,
+                  (unsigned long)mem.string_bytes,
+                  (unsigned long)mem.queue_bytes);
+#endif
+    writer_printf(w, "}\n");
+}
+
+/*
+ * Render all metrics into buf in a single locked pass, without allocating.
+ * *written receives the full length (excluding the terminator) even when
+ * the buffer is too small, so callers can retry with a larger one.
+ */
+ss_error_t ss_metrics_write(char* buf, size_t len, ss_format_t format,
+                            size_t* written) {
+    ss_writer_t w = {0};
+
+    if (!g_context || (!buf && len > 0)) return SS_ERR_NULL_PARAM;
+    if (format != SS_FMT_PROMETHEUS && format != SS_FMT_JSON) {
+        return SS_ERR_UNSUPPORTED;
+    }
+    w.buf = buf;
+    w.len = len;
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
+    if (format == SS_FMT_PROMETHEUS) {
+        metrics_prometheus(&w);
+    } else {
+        metrics_json(&w);
     }
+
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    if (written) *written = w.pos;
+    if (w.failed) return SS_ERR_IO;
+    return w.pos < len ? SS_OK : SS_ERR_BUFFER_TOO_SMALL;
 }
 #endif
 
@@ -1363,6 +3982,7 @@ void ss_set_thread_safe(int enabled) {
     }
     
     g_context->thread_safe = enabled;
+    select_emit_path();
 #else
     (void)enabled; /* unused */
 #endif
@@ -1379,12 +3999,12 @@ ss_error_t ss_set_namespace(const char* ns) {
     if (!g_context) return SS_ERR_NULL_PARAM;
 
     if (g_context->namespace) {
-        SS_FREE(g_context->namespace);
+        SS_ACCT_FREE_STRING(SS_ALLOC_NAMES, g_context->namespace);
         g_context->namespace = NULL;
     }
 
     if (ns) {
-        g_context->namespace = SS_STRDUP(ns);
+        g_context->namespace = SS_ACCT_STRDUP(SS_ALLOC_NAMES, ns);
         if (!g_context->namespace) return SS_ERR_MEMORY;
     }
 
@@ -1433,12 +4053,24 @@ ss_error_t ss_emit_deferred(const char* signal_name, const ss_data_t* data) {
         return SS_ERR_NULL_PARAM;
     }
 
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+
     if (g_context->deferred_count >= SS_DEFERRED_QUEUE_SIZE) {
+#if SS_ENABLE_QUEUE_STATS
+        g_context->deferred_stats.dropped++;
+#endif
         report_error(SS_ERR_WOULD_OVERFLOW, "deferred queue full");
+#if SS_ENABLE_THREAD_SAFETY
+        if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
         return SS_ERR_WOULD_OVERFLOW;
     }
 
-    entry = &g_context->deferred_queue[g_context->deferred_count];
+    entry = &g_context->deferred_queue[
+        (g_context->deferred_head + g_context->deferred_count) %
+        SS_DEFERRED_QUEUE_SIZE];
     ss_strscpy(entry->signal_name, signal_name, SS_MAX_SIGNAL_NAME_LENGTH);
     entry->has_string = 0;
 
@@ -1446,8 +4078,14 @@ ss_error_t ss_emit_deferred(const char* signal_name, const ss_data_t* data) {
         entry->data = *data;
         /* Duplicate string data to avoid dangling pointer */
         if (data->type == SS_TYPE_STRING && data->value.s_val) {
-            entry->data.value.s_val = SS_STRDUP(data->value.s_val);
-            if (!entry->data.value.s_val) return SS_ERR_MEMORY;
+            entry->data.value.s_val = SS_ACCT_STRDUP(SS_ALLOC_PAYLOADS,
+                                                     data->value.s_val);
+            if (!entry->data.value.s_val) {
+#if SS_ENABLE_THREAD_SAFETY
+                if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+                return SS_ERR_MEMORY;
+            }
             entry->has_string = 1;
         }
     } else {
@@ -1455,45 +4093,108 @@ ss_error_t ss_emit_deferred(const char* signal_name, const ss_data_t* data) {
         entry->data.type = SS_TYPE_VOID;
     }
 
+#if SS_ENABLE_TRACE_BUFFER
+    entry->flow_id = ++g_context->next_flow_id;
+#endif
+    SS_TRACE_EVENT(SS_TREC_DEFER, signal_name, NULL, entry->flow_id);
+
     g_context->deferred_count++;
+    SS_USDT2(deferred_enqueue, entry->signal_name, g_context->deferred_count);
+#if SS_ENABLE_THREAD_STATS
+    if (g_context->thread_stats_enabled) {
+        THREAD_STAT_ADD(thread_block(), deferred_enqueues, 1);
+    }
+#endif
+#if SS_ENABLE_QUEUE_STATS
+    g_context->deferred_stats.enqueued++;
+    if (g_context->deferred_count > g_context->deferred_stats.high_water) {
+        g_context->deferred_stats.high_water = g_context->deferred_count;
+    }
+#endif
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
     return SS_OK;
 }
 
+/*
+ * Entries are popped one at a time and emitted with the lock released, so
+ * slots may enqueue (the mutex is recursive) or flush again without
+ * touching the entry in flight. Only the entries queued at the start are
+ * flushed, so slots that keep enqueueing cannot loop forever.
+ */
 ss_error_t ss_flush_deferred(void) {
-    size_t i, count;
+    ss_deferred_entry_t entry;
+    size_t budget, count = 0;
     ss_error_t result = SS_OK;
+#if SS_ENABLE_QUEUE_STATS
+    uint64_t start = 0;
+#endif
 
     if (!g_context) return SS_ERR_NULL_PARAM;
 
-    /* Snapshot count to avoid infinite loops if slots enqueue more */
-    count = g_context->deferred_count;
-    g_context->deferred_count = 0;
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+    budget = g_context->deferred_count;
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+    if (budget == 0) return SS_OK;
+#if SS_ENABLE_QUEUE_STATS
+    start = get_time_ns();
+#endif
 
-    for (i = 0; i < count; i++) {
-        ss_deferred_entry_t* entry = &g_context->deferred_queue[i];
-        ss_error_t err = ss_emit(entry->signal_name, &entry->data);
+    while (count < budget) {
+        ss_error_t err;
+
+#if SS_ENABLE_THREAD_SAFETY
+        if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+        if (g_context->deferred_count == 0) {
+            /* A nested or concurrent flush drained the rest */
+#if SS_ENABLE_THREAD_SAFETY
+            if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+            break;
+        }
+        entry = g_context->deferred_queue[g_context->deferred_head];
+        g_context->deferred_head =
+            (g_context->deferred_head + 1) % SS_DEFERRED_QUEUE_SIZE;
+        g_context->deferred_count--;
+        SS_TRACE_EVENT(SS_TREC_DEFER_FLUSH, entry.signal_name, NULL,
+                       entry.flow_id);
+#if SS_ENABLE_THREAD_SAFETY
+        if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+
+        err = ss_emit(entry.signal_name, &entry.data);
         if (err != SS_OK) result = err;
 
-        if (entry->has_string) {
-            SS_FREE((void*)entry->data.value.s_val);
+        if (entry.has_string) {
+            SS_ACCT_FREE_STRING(SS_ALLOC_PAYLOADS, entry.data.value.s_val);
         }
+        count++;
     }
 
+#if SS_ENABLE_QUEUE_STATS
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+    queue_record_flush(&g_context->deferred_stats, count,
+                       get_time_ns() - start);
+#if SS_ENABLE_THREAD_SAFETY
+    if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+#endif
+    SS_USDT2(flush, "deferred", count);
     return result;
 }
 
 /* Batch operations */
-#ifndef SS_BATCH_MAX_ENTRIES
-#define SS_BATCH_MAX_ENTRIES SS_DEFERRED_QUEUE_SIZE
-#endif
-
-struct ss_batch {
-    ss_deferred_entry_t entries[SS_BATCH_MAX_ENTRIES];
-    size_t count;
-};
-
 ss_batch_t* ss_batch_create(void) {
-    return (ss_batch_t*)SS_CALLOC(1, sizeof(ss_batch_t));
+    return (ss_batch_t*)SS_ACCT_CALLOC(SS_ALLOC_QUEUES, 1, sizeof(ss_batch_t));
 }
 
 void ss_batch_destroy(ss_batch_t* batch) {
@@ -1502,10 +4203,14 @@ void ss_batch_destroy(ss_batch_t* batch) {
 
     for (i = 0; i < batch->count; i++) {
         if (batch->entries[i].has_string) {
-            SS_FREE((void*)batch->entries[i].data.value.s_val);
+            SS_ACCT_FREE_STRING(SS_ALLOC_PAYLOADS,
+                                batch->entries[i].data.value.s_val);
         }
     }
-    SS_FREE(batch);
+#if SS_ENABLE_QUEUE_STATS
+    SS_ATOMIC_FETCH_ADD(&g_batch_stats.depth, (size_t)0 - batch->count);
+#endif
+    SS_ACCT_FREE(SS_ALLOC_QUEUES, batch, sizeof(ss_batch_t));
 }
 
 ss_error_t ss_batch_add(ss_batch_t* batch, const char* signal_name,
@@ -1513,7 +4218,12 @@ ss_error_t ss_batch_add(ss_batch_t* batch, const char* signal_name,
     ss_deferred_entry_t* entry;
 
     if (!batch || !signal_name) return SS_ERR_NULL_PARAM;
-    if (batch->count >= SS_BATCH_MAX_ENTRIES) return SS_ERR_WOULD_OVERFLOW;
+    if (batch->count >= SS_BATCH_MAX_ENTRIES) {
+#if SS_ENABLE_QUEUE_STATS
+        SS_ATOMIC_FETCH_ADD(&g_batch_stats.dropped, 1);
+#endif
+        return SS_ERR_WOULD_OVERFLOW;
+    }
 
     entry = &batch->entries[batch->count];
     ss_strscpy(entry->signal_name, signal_name, SS_MAX_SIGNAL_NAME_LENGTH);
@@ -1522,7 +4232,8 @@ ss_error_t ss_batch_add(ss_batch_t* batch, const char* signal_name,
     if (data) {
         entry->data = *data;
         if (data->type == SS_TYPE_STRING && data->value.s_val) {
-            entry->data.value.s_val = SS_STRDUP(data->value.s_val);
+            entry->data.value.s_val = SS_ACCT_STRDUP(SS_ALLOC_PAYLOADS,
+                                                     data->value.s_val);
             if (!entry->data.value.s_val) return SS_ERR_MEMORY;
             entry->has_string = 1;
         }
@@ -1532,14 +4243,25 @@ ss_error_t ss_batch_add(ss_batch_t* batch, const char* signal_name,
     }
 
     batch->count++;
+#if SS_ENABLE_QUEUE_STATS
+    SS_ATOMIC_FETCH_ADD(&g_batch_stats.enqueued, 1);
+    SS_ATOMIC_FETCH_ADD(&g_batch_stats.depth, 1);
+    atomic_store_max(&g_batch_stats.high_water, batch->count);
+#endif
     return SS_OK;
 }
 
 ss_error_t ss_batch_emit(ss_batch_t* batch) {
     size_t i;
     ss_error_t result = SS_OK;
+#if SS_ENABLE_QUEUE_STATS
+    uint64_t start;
+#endif
 
     if (!batch) return SS_ERR_NULL_PARAM;
+#if SS_ENABLE_QUEUE_STATS
+    start = (g_context && batch->count) ? get_time_ns() : 0;
+#endif
 
     for (i = 0; i < batch->count; i++) {
         ss_deferred_entry_t* entry = &batch->entries[i];
@@ -1547,11 +4269,26 @@ ss_error_t ss_batch_emit(ss_batch_t* batch) {
         if (err != SS_OK) result = err;
 
         if (entry->has_string) {
-            SS_FREE((void*)entry->data.value.s_val);
+            SS_ACCT_FREE_STRING(SS_ALLOC_PAYLOADS, entry->data.value.s_val);
             entry->has_string = 0;
         }
     }
 
+#if SS_ENABLE_QUEUE_STATS
+    SS_ATOMIC_FETCH_ADD(&g_batch_stats.depth, (size_t)0 - batch->count);
+    if (g_context && batch->count > 0) {
+        uint64_t elapsed = get_time_ns() - start;
+#if SS_ENABLE_THREAD_SAFETY
+        if (g_context->thread_safe) SS_MUTEX_LOCK(&g_context->mutex);
+#endif
+        queue_record_flush(&g_batch_stats, batch->count, elapsed);
+#if SS_ENABLE_THREAD_SAFETY
+        if (g_context->thread_safe) SS_MUTEX_UNLOCK(&g_context->mutex);
+#endif
+    }
+#endif
+    if (batch->count > 0) SS_USDT2(flush, "batch", batch->count);
     batch->count = 0;
     return result;
 }
+
@@ -13,6 +13,12 @@
  * ss_config.h works identically for both versions.
  */
 
+#ifndef _WIN32
+/* strdup and clock_gettime are POSIX, not C89: without this, -std=c89
+ * leaves strdup undeclared and its result truncated to int */
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "ss_lib.h"
 #include <stdlib.h>
 #include <string.h>
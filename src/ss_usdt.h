@@ -0,0 +1,90 @@
+#ifndef SS_USDT_H
+#define SS_USDT_H
+
+/*
+ * USDT (SystemTap SDT) probes for bpftrace, perf and systemtap.
+ *
+ * Each probe compiles to a single nop plus an ELF note describing where
+ * its arguments live; attaching a tracer patches the nop at run time.
+ * Arguments are still computed when no tracer is attached, so probe
+ * sites pass only values that are already at hand.
+ *
+ * <sys/sdt.h> is used when available. Otherwise a minimal equivalent
+ * emitting the same .note.stapsdt format is provided for GCC/Clang on
+ * x86-64 and AArch64 ELF targets. All arguments are passed as 64-bit
+ * unsigned values.
+ */
+
+#include "ss_config.h"
+
+#if SS_ENABLE_USDT
+
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define SS_USDT_HAVE_SYS_SDT 1
+#endif
+#endif
+
+#if defined(SS_USDT_HAVE_SYS_SDT)
+#include <sys/sdt.h>
+
+#define SS_USDT0(name) STAP_PROBE(ss, name)
+#define SS_USDT1(name, a) STAP_PROBE1(ss, name, a)
+#define SS_USDT2(name, a, b) STAP_PROBE2(ss, name, a, b)
+#define SS_USDT3(name, a, b, c) STAP_PROBE3(ss, name, a, b, c)
+
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__ELF__) && \
+      (defined(__x86_64__) || defined(__aarch64__))
+#include <stdint.h>
+
+#define SS_USDT_NOTE(name, args) \
+    "990: nop\n" \
+    ".pushsection .note.stapsdt,\"?\",\"note\"\n" \
+    ".balign 4\n" \
+    ".4byte 992f-991f, 994f-993f, 3\n" \
+    "991: .asciz \"stapsdt\"\n" \
+    "992: .balign 4\n" \
+    "993: .8byte 990b\n" \
+    ".8byte _.stapsdt.base\n" \
+    ".8byte 0\n" \
+    ".asciz \"ss\"\n" \
+    ".asciz \"" #name "\"\n" \
+    ".asciz \"" args "\"\n" \
+    "994: .balign 4\n" \
+    ".popsection\n" \
+    ".ifndef _.stapsdt.base\n" \
+    ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n" \
+    ".weak _.stapsdt.base\n" \
+    ".hidden _.stapsdt.base\n" \
+    "_.stapsdt.base: .space 1\n" \
+    ".size _.stapsdt.base, 1\n" \
+    ".popsection\n" \
+    ".endif\n"
+
+#define SS_USDT_ARG(v) "r"((uint64_t)(uintptr_t)(v))
+
+#define SS_USDT0(name) \
+    __asm__ __volatile__(SS_USDT_NOTE(name, ""))
+#define SS_USDT1(name, a) \
+    __asm__ __volatile__(SS_USDT_NOTE(name, "8@%0") :: SS_USDT_ARG(a))
+#define SS_USDT2(name, a, b) \
+    __asm__ __volatile__(SS_USDT_NOTE(name, "8@%0 8@%1") \
+                         :: SS_USDT_ARG(a), SS_USDT_ARG(b))
+#define SS_USDT3(name, a, b, c) \
+    __asm__ __volatile__(SS_USDT_NOTE(name, "8@%0 8@%1 8@%2") \
+                         :: SS_USDT_ARG(a), SS_USDT_ARG(b), SS_USDT_ARG(c))
+
+#else
+#error "SS_ENABLE_USDT requires <sys/sdt.h>, or GCC/Clang on x86-64 or AArch64 ELF"
+#endif
+
+#else /* !SS_ENABLE_USDT */
+
+#define SS_USDT0(name) ((void)0)
+#define SS_USDT1(name, a) ((void)0)
+#define SS_USDT2(name, a, b) ((void)0)
+#define SS_USDT3(name, a, b, c) ((void)0)
+
+#endif
+
+#endif /* SS_USDT_H */
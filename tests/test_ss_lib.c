@@ -1,7 +1,11 @@
 #include "ss_lib.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#if SS_ENABLE_THREAD_STATS && SS_ENABLE_THREAD_SAFETY && !defined(_WIN32)
+#include <pthread.h>
+#endif
 
 static int g_test_counter = 0;
 
@@ -444,10 +448,77 @@ void test_deferred_emission(void) {
     assert(ss_flush_deferred() == SS_OK);
     assert(g_test_counter == 60);
 
+    /* A full queue that wraps past the end of the ring */
+    {
+        ss_data_t one;
+        int i;
+
+        memset(&one, 0, sizeof(one));
+        one.type = SS_TYPE_INT;
+        one.value.i_val = 1;
+        for (i = 0; i < SS_DEFERRED_QUEUE_SIZE; i++) {
+            assert(ss_emit_deferred("deferred2", &one) == SS_OK);
+        }
+        assert(ss_emit_deferred("deferred2", &one) == SS_ERR_WOULD_OVERFLOW);
+        assert(ss_flush_deferred() == SS_OK);
+        assert(g_test_counter == 60 + SS_DEFERRED_QUEUE_SIZE);
+    }
+
     ss_cleanup();
     printf("Deferred emission tests passed!\n");
 }
 
+/* Defers onto "reentrant_b" while its own deferred entry is dispatched */
+static void reentrant_a_slot(const ss_data_t* data, void* user_data) {
+    ss_data_t* next = ss_data_create(SS_TYPE_STRING);
+    (void)user_data;
+    assert(next != NULL);
+    assert(ss_data_set_string(next, "second") == SS_OK);
+    assert(ss_emit_deferred("reentrant_b", next) == SS_OK);
+    ss_data_destroy(next);
+    /* The entry being dispatched must not have been reused */
+    assert(strcmp(ss_data_get_string(data), "first") == 0);
+    g_test_counter++;
+}
+
+static void reentrant_b_slot(const ss_data_t* data, void* user_data) {
+    (void)user_data;
+    assert(strcmp(ss_data_get_string(data), "second") == 0);
+    g_test_counter += 10;
+}
+
+void test_deferred_reentrant(void) {
+    printf("\n=== Testing Deferred Emission From Slots ===\n");
+
+    assert(ss_init() == SS_OK);
+#if SS_ENABLE_THREAD_SAFETY
+    ss_set_thread_safe(1);
+#endif
+    assert(ss_signal_register("reentrant_a") == SS_OK);
+    assert(ss_signal_register("reentrant_b") == SS_OK);
+    assert(ss_connect("reentrant_a", reentrant_a_slot, NULL) == SS_OK);
+    assert(ss_connect("reentrant_b", reentrant_b_slot, NULL) == SS_OK);
+
+    ss_data_t* first = ss_data_create(SS_TYPE_STRING);
+    assert(first != NULL);
+    assert(ss_data_set_string(first, "first") == SS_OK);
+    assert(ss_emit_deferred("reentrant_a", first) == SS_OK);
+    ss_data_destroy(first);
+
+    /* The entry queued by the slot waits for the next flush */
+    g_test_counter = 0;
+    assert(ss_flush_deferred() == SS_OK);
+    assert(g_test_counter == 1);
+    assert(ss_flush_deferred() == SS_OK);
+    assert(g_test_counter == 11);
+
+#if SS_ENABLE_THREAD_SAFETY
+    ss_set_thread_safe(0);
+#endif
+    ss_cleanup();
+    printf("Deferred reentrancy tests passed!\n");
+}
+
 void test_batch_operations(void) {
     printf("\n=== Testing Batch Operations ===\n");
 
@@ -492,6 +563,977 @@ void test_batch_operations(void) {
     printf("Batch operations tests passed!\n");
 }
 
+#if SS_ENABLE_TRACE_BUFFER
+static void trace_nested_slot(const ss_data_t* data, void* user_data) {
+    (void)data;
+    (void)user_data;
+    ss_emit_void("trace_inner");
+}
+
+static FILE* g_trace_inner_export;
+
+static void trace_export_slot(const ss_data_t* data, void* user_data) {
+    (void)data;
+    (void)user_data;
+    assert(ss_trace_export_chrome(g_trace_inner_export) == SS_OK);
+}
+
+/* Occurrences of needle in the whole of f */
+static size_t count_in_file(FILE* f, const char* needle) {
+    size_t n = 0, len;
+    long size;
+    char* text;
+    const char* p;
+
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    rewind(f);
+    text = malloc((size_t)size + 1);
+    assert(text != NULL);
+    len = fread(text, 1, (size_t)size, f);
+    text[len] = '\0';
+    for (p = strstr(text, needle); p; p = strstr(p + 1, needle)) n++;
+    free(text);
+    return n;
+}
+
+void test_trace_buffer_export(void) {
+    printf("\n=== Testing Trace Buffer Export ===\n");
+
+    assert(ss_init() == SS_OK);
+    assert(ss_signal_register("trace_outer") == SS_OK);
+    assert(ss_signal_register("trace_inner") == SS_OK);
+    assert(ss_connect("trace_outer", trace_nested_slot, NULL) == SS_OK);
+
+    /* Nothing is recorded until the buffer is started */
+    assert(ss_emit_void("trace_outer") == SS_OK);
+
+    assert(ss_trace_buffer_start() == SS_OK);
+    assert(ss_emit_void("trace_outer") == SS_OK);
+    assert(ss_emit_deferred("trace_inner", NULL) == SS_OK);
+    assert(ss_flush_deferred() == SS_OK);
+    ss_trace_buffer_stop();
+
+    FILE* out = tmpfile();
+    assert(out != NULL);
+    assert(ss_trace_export_chrome(out) == SS_OK);
+
+    char buf[4096];
+    rewind(out);
+    size_t len = fread(buf, 1, sizeof(buf) - 1, out);
+    buf[len] = '\0';
+    fclose(out);
+
+    assert(strncmp(buf, "{\"traceEvents\":[", 16) == 0);
+    assert(strstr(buf, "\"name\":\"trace_outer\"") != NULL);
+    assert(strstr(buf, "\"cat\":\"slot\",\"ph\":\"B\"") != NULL);
+    assert(strstr(buf, "\"ph\":\"s\"") != NULL);
+    assert(strstr(buf, "\"ph\":\"f\"") != NULL);
+    assert(strstr(buf, "\"dropped_records\":0") != NULL);
+
+#ifndef _WIN32
+    /* A stream that rejects writes is an output failure */
+    out = fopen("/dev/null", "r");
+    assert(out != NULL);
+    assert(ss_trace_export_chrome(out) == SS_ERR_IO);
+    fclose(out);
+#endif
+
+    /* Clearing drops every record */
+    ss_trace_buffer_clear();
+    out = tmpfile();
+    assert(ss_trace_export_chrome(out) == SS_OK);
+    rewind(out);
+    len = fread(buf, 1, sizeof(buf) - 1, out);
+    buf[len] = '\0';
+    fclose(out);
+    assert(strstr(buf, "{\"traceEvents\":[]") == buf);
+
+    /* After the ring wraps, ends whose begins were overwritten are dropped */
+    assert(ss_trace_buffer_start() == SS_OK);
+    for (int i = 0; i < SS_TRACE_BUFFER_SIZE / 6 + 16; i++) {
+        assert(ss_emit_void("trace_outer") == SS_OK);
+    }
+    ss_trace_buffer_stop();
+    out = tmpfile();
+    assert(ss_trace_export_chrome(out) == SS_OK);
+    assert(count_in_file(out, "\"ph\":\"B\"") == count_in_file(out, "\"ph\":\"E\""));
+    assert(count_in_file(out, "\"dropped_records\":0") == 0);
+    fclose(out);
+
+    /* Slices still open at export time are closed */
+    ss_trace_buffer_clear();
+    assert(ss_signal_register("trace_export") == SS_OK);
+    assert(ss_connect("trace_export", trace_export_slot, NULL) == SS_OK);
+    g_trace_inner_export = tmpfile();
+    assert(g_trace_inner_export != NULL);
+    assert(ss_trace_buffer_start() == SS_OK);
+    assert(ss_emit_deferred("trace_export", NULL) == SS_OK);
+    assert(ss_flush_deferred() == SS_OK);
+    ss_trace_buffer_stop();
+    assert(count_in_file(g_trace_inner_export, "\"ph\":\"B\"") == 4);
+    assert(count_in_file(g_trace_inner_export, "\"ph\":\"E\"") == 4);
+    assert(count_in_file(g_trace_inner_export, "\"bp\":\"e\"") == 1);
+    fclose(g_trace_inner_export);
+
+    ss_cleanup();
+    printf("Trace buffer export tests passed!\n");
+}
+#endif
+
+#if SS_ENABLE_PERFORMANCE_STATS
+static uint64_t fake_clock(void* user_data) {
+    uint64_t* now = (uint64_t*)user_data;
+    *now += 100;
+    return *now;
+}
+
+void test_profiling_clock(void) {
+    printf("\n=== Testing Profiling Clock ===\n");
+
+    assert(ss_init() == SS_OK);
+    assert(ss_signal_register("clock_signal") == SS_OK);
+
+    /* User clock: every reading advances 100 ns, so each emit takes 100 */
+    uint64_t now = 0;
+    assert(ss_set_clock(fake_clock, &now) == SS_OK);
+    assert(ss_clock_now_ns() == 100);
+    assert(ss_enable_profiling(1) == SS_OK);
+    for (int i = 0; i < 10; i++) {
+        assert(ss_emit_void("clock_signal") == SS_OK);
+    }
+
+    ss_perf_stats_t stats;
+    assert(ss_get_perf_stats("clock_signal", &stats) == SS_OK);
+    assert(stats.total_emissions == 10);
+    assert(stats.total_time_ns == 1000);
+    assert(stats.min_time_ns == 100 && stats.max_time_ns == 100);
+
+    /* Built-in sources are monotonic */
+    assert(ss_set_clock(NULL, NULL) == SS_OK);
+    assert(ss_set_clock_source(SS_CLOCK_MONOTONIC) == SS_OK);
+    uint64_t t1 = ss_clock_now_ns();
+    uint64_t t2 = ss_clock_now_ns();
+    assert(t2 >= t1);
+
+    ss_error_t err = ss_set_clock_source(SS_CLOCK_TSC);
+    assert(err == SS_OK || err == SS_ERR_UNSUPPORTED);
+    if (err == SS_OK) {
+        t1 = ss_clock_now_ns();
+        t2 = ss_clock_now_ns();
+        assert(t2 >= t1);
+    }
+
+    ss_cleanup();
+    printf("Profiling clock tests passed!\n");
+}
+
+void test_sampled_profiling(void) {
+    printf("\n=== Testing Sampled Profiling ===\n");
+
+    assert(ss_init() == SS_OK);
+    assert(ss_signal_register("sampled") == SS_OK);
+    assert(ss_signal_register("unsampled") == SS_OK);
+
+    uint64_t now = 0;
+    assert(ss_set_clock(fake_clock, &now) == SS_OK);
+    assert(ss_enable_profiling(1) == SS_OK);
+
+    /* Global 1-in-1000, overridden to 1-in-4 for one signal */
+    assert(ss_set_profiling_sample_rate(NULL, 1000) == SS_OK);
+    assert(ss_set_profiling_sample_rate("sampled", 4) == SS_OK);
+    assert(ss_set_profiling_sample_rate("missing", 4) == SS_ERR_NOT_FOUND);
+
+    for (int i = 0; i < 4000; i++) {
+        assert(ss_emit_void("sampled") == SS_OK);
+        assert(ss_emit_void("unsampled") == SS_OK);
+    }
+
+    ss_perf_stats_t stats;
+    assert(ss_get_perf_stats("sampled", &stats) == SS_OK);
+    assert(stats.total_emissions == 4000);
+    assert(stats.sampled_emissions > 700 && stats.sampled_emissions < 1300);
+    assert(stats.avg_time_ns == 100);
+    /* Sampled time is scaled up to every emission */
+    assert(stats.total_time_ns == 400000);
+
+    assert(ss_get_perf_stats("unsampled", &stats) == SS_OK);
+    assert(stats.total_emissions == 4000);
+    assert(stats.sampled_emissions < 40);
+
+    /* Rate 0 on a signal falls back to the global rate */
+    assert(ss_set_profiling_sample_rate(NULL, 1) == SS_OK);
+    assert(ss_set_profiling_sample_rate("sampled", 0) == SS_OK);
+    ss_reset_perf_stats();
+    for (int i = 0; i < 100; i++) {
+        assert(ss_emit_void("sampled") == SS_OK);
+    }
+    assert(ss_get_perf_stats("sampled", &stats) == SS_OK);
+    assert(stats.sampled_emissions == 100);
+
+    ss_cleanup();
+    printf("Sampled profiling tests passed!\n");
+}
+
+void test_perf_histogram(void) {
+    printf("\n=== Testing Latency Histograms ===\n");
+
+    ss_histogram_t* hist = calloc(1, sizeof(ss_histogram_t));
+    ss_histogram_t* other = calloc(1, sizeof(ss_histogram_t));
+    assert(hist != NULL && other != NULL);
+
+    /* 1..1000 ns uniformly: percentiles within the sub-bucket error */
+    for (uint64_t v = 1; v <= 1000; v++) {
+        ss_histogram_record(hist, v);
+    }
+    assert(hist->total_count == 1000);
+    assert(hist->max_value == 1000);
+    assert(ss_histogram_percentile(hist, 100.0) == 1000);
+
+    uint64_t p50 = ss_histogram_percentile(hist, 50.0);
+    uint64_t p99 = ss_histogram_percentile(hist, 99.0);
+    assert(p50 >= 500 && p50 <= 500 + 500 / 8 + 1);
+    assert(p99 >= 990 && p99 <= 1000);
+
+    /* Small values are recorded exactly */
+    ss_histogram_reset(other);
+    ss_histogram_record(other, 3);
+    assert(ss_histogram_percentile(other, 50.0) == 3);
+
+    /* Values beyond the tracked range clamp into the last bucket */
+    ss_histogram_record(other, UINT64_MAX);
+    assert(other->total_count == 2);
+    assert(ss_histogram_percentile(other, 100.0) == UINT64_MAX);
+
+    ss_histogram_merge(hist, other);
+    assert(hist->total_count == 1002);
+    assert(hist->max_value == UINT64_MAX);
+
+    /* Per-signal histograms fed by ss_emit */
+    assert(ss_init() == SS_OK);
+    assert(ss_signal_register("hist_signal") == SS_OK);
+    assert(ss_enable_profiling(1) == SS_OK);
+    for (int i = 0; i < 100; i++) {
+        assert(ss_emit_void("hist_signal") == SS_OK);
+    }
+
+    const double pct[3] = {50.0, 99.0, 99.9};
+    uint64_t out[3];
+    assert(ss_get_perf_percentiles("hist_signal", pct, 3, out) == SS_OK);
+    assert(out[0] <= out[1] && out[1] <= out[2]);
+    assert(ss_get_perf_percentiles("missing", pct, 3, out) == SS_ERR_NOT_FOUND);
+
+    assert(ss_get_perf_histogram("hist_signal", hist) == SS_OK);
+    assert(hist->total_count == 100);
+
+    ss_reset_perf_stats();
+    assert(ss_get_perf_histogram("hist_signal", hist) == SS_OK);
+    assert(hist->total_count == 0);
+
+    ss_cleanup();
+    free(hist);
+    free(other);
+    printf("Latency histogram tests passed!\n");
+}
+#endif
+
+#if SS_ENABLE_INTROSPECTION
+void test_metrics_export(void) {
+    printf("\n=== Testing Metrics Export ===\n");
+
+    static char buf[1 << 18];   /* Every histogram bucket is written */
+    char tiny[16];
+    size_t written = 0;
+    size_t needed = 0;
+    int counter = 0;
+
+    assert(ss_init() == SS_OK);
+    assert(ss_signal_register("metric \"quoted\"") == SS_OK);
+    assert(ss_signal_register("metric_plain") == SS_OK);
+    assert(ss_connect("metric_plain", test_slot_void, &counter) == SS_OK);
+    assert(ss_emit_void("metric_plain") == SS_OK);
+
+    assert(ss_metrics_write(buf, sizeof(buf), SS_FMT_PROMETHEUS,
+                            &written) == SS_OK);
+    assert(written == strlen(buf));
+    assert(strstr(buf, "# TYPE ss_signal_slots gauge") != NULL);
+    assert(strstr(buf, "ss_signal_slots{signal=\"metric_plain\"} 1") != NULL);
+    assert(strstr(buf, "signal=\"metric \\\"quoted\\\"\"") != NULL);
+    assert(strstr(buf, "ss_queue_depth{queue=\"deferred\"} 0") != NULL);
+#if SS_ENABLE_PERFORMANCE_STATS
+    /* Unprofiled signals still list every bucket boundary */
+    {
+        const char* series = "ss_signal_latency_ns_bucket{signal=\"metric_plain\"";
+        const char* p;
+        size_t buckets = 0;
+
+        for (p = strstr(buf, series); p; p = strstr(p + 1, series)) buckets++;
+        assert(buckets == SS_PERF_HISTOGRAM_BUCKETS);
+        assert(strstr(buf, "ss_signal_latency_ns_bucket{signal=\"metric_plain\",le=\"0\"} 0") != NULL);
+        assert(strstr(buf, "ss_signal_latency_ns_bucket{signal=\"metric_plain\",le=\"+Inf\"} 0") != NULL);
+    }
+#endif
+
+    assert(ss_metrics_write(buf, sizeof(buf), SS_FMT_JSON, &written) == SS_OK);
+    assert(buf[0] == '{' && buf[written - 2] == '}');
+    assert(strstr(buf, "\"name\":\"metric_plain\",\"slots\":1") != NULL);
+    assert(strstr(buf, "\"queues\":{\"deferred\"") != NULL);
+
+    /* Truncated output still reports the full size */
+    assert(ss_metrics_write(tiny, sizeof(tiny), SS_FMT_JSON,
+                            &needed) == SS_ERR_BUFFER_TOO_SMALL);
+    assert(needed == written);
+    assert(tiny[sizeof(tiny) - 1] == '\0');
+    assert(ss_metrics_write(NULL, 0, SS_FMT_JSON, &needed) ==
+           SS_ERR_BUFFER_TOO_SMALL);
+    assert(needed == written);
+
+    assert(ss_metrics_write(buf, sizeof(buf), (ss_format_t)99, NULL) ==
+           SS_ERR_UNSUPPORTED);
+
+    ss_cleanup();
+    printf("Metrics export tests passed!\n");
+}
+#endif
+
+#if SS_ENABLE_QUEUE_STATS
+void test_queue_stats(void) {
+    printf("\n=== Testing Queue Telemetry ===\n");
+
+    ss_queue_stats_t* qs = calloc(1, sizeof(ss_queue_stats_t));
+    int counter = 0;
+    assert(qs != NULL);
+
+    assert(ss_init() == SS_OK);
+    ss_reset_queue_stats();
+    assert(ss_signal_register("queued") == SS_OK);
+    assert(ss_connect("queued", test_slot_void, &counter) == SS_OK);
+
+    /* Deferred queue: fill past capacity, then flush */
+    for (int i = 0; i < SS_DEFERRED_QUEUE_SIZE; i++) {
+        assert(ss_emit_deferred("queued", NULL) == SS_OK);
+    }
+    assert(ss_emit_deferred("queued", NULL) == SS_ERR_WOULD_OVERFLOW);
+    assert(ss_get_queue_stats(SS_QUEUE_DEFERRED, qs) == SS_OK);
+    assert(qs->capacity == SS_DEFERRED_QUEUE_SIZE);
+    assert(qs->depth == SS_DEFERRED_QUEUE_SIZE);
+    assert(qs->high_water == SS_DEFERRED_QUEUE_SIZE);
+    assert(qs->enqueued == SS_DEFERRED_QUEUE_SIZE);
+    assert(qs->dropped == 1);
+
+    assert(ss_flush_deferred() == SS_OK);
+    assert(ss_flush_deferred() == SS_OK);  /* empty flush is not counted */
+    assert(counter == SS_DEFERRED_QUEUE_SIZE);
+    assert(ss_get_queue_stats(SS_QUEUE_DEFERRED, qs) == SS_OK);
+    assert(qs->depth == 0);
+    assert(qs->high_water == SS_DEFERRED_QUEUE_SIZE);
+    assert(qs->flushes == 1);
+    assert(qs->flushed == SS_DEFERRED_QUEUE_SIZE);
+    assert(qs->flush_histogram.total_count == 1);
+
+    /* Batches are aggregated; depth spans live batches */
+    ss_batch_t* batch = ss_batch_create();
+    assert(batch != NULL);
+    assert(ss_batch_add(batch, "queued", NULL) == SS_OK);
+    assert(ss_batch_add(batch, "queued", NULL) == SS_OK);
+    assert(ss_get_queue_stats(SS_QUEUE_BATCH, qs) == SS_OK);
+    assert(qs->depth == 2 && qs->high_water == 2 && qs->enqueued == 2);
+
+    /* Reset keeps live depth */
+    ss_reset_queue_stats();
+    assert(ss_get_queue_stats(SS_QUEUE_BATCH, qs) == SS_OK);
+    assert(qs->depth == 2 && qs->enqueued == 0);
+
+    assert(ss_batch_emit(batch) == SS_OK);
+    assert(ss_get_queue_stats(SS_QUEUE_BATCH, qs) == SS_OK);
+    assert(qs->depth == 0 && qs->flushes == 1 && qs->flushed == 2);
+    ss_batch_destroy(batch);
+
+#if SS_ENABLE_ISR_SAFE
+    /* ISR queue is drained by ss_process_isr_queue */
+    g_test_counter = 0;
+    assert(ss_signal_register("isr_queued") == SS_OK);
+    assert(ss_connect("isr_queued", test_slot_int, NULL) == SS_OK);
+    for (int i = 0; i < SS_ISR_QUEUE_SIZE; i++) {
+        assert(ss_emit_from_isr("isr_queued", 1) == SS_OK);
+    }
+    assert(ss_emit_from_isr("isr_queued", 1) == SS_ERR_WOULD_OVERFLOW);
+    assert(ss_get_queue_stats(SS_QUEUE_ISR, qs) == SS_OK);
+    assert(qs->depth == SS_ISR_QUEUE_SIZE);
+    assert(qs->high_water == SS_ISR_QUEUE_SIZE);
+    assert(qs->enqueued == SS_ISR_QUEUE_SIZE && qs->dropped == 1);
+
+    assert(ss_process_isr_queue() == SS_OK);
+    assert(g_test_counter == SS_ISR_QUEUE_SIZE);
+    assert(ss_get_queue_stats(SS_QUEUE_ISR, qs) == SS_OK);
+    assert(qs->depth == 0 && qs->flushes == 1);
+    assert(qs->flushed == SS_ISR_QUEUE_SIZE);
+#endif
+
+    assert(ss_get_queue_stats(SS_QUEUE_COUNT, qs) == SS_ERR_INVALID_TYPE);
+    assert(ss_get_queue_stats(SS_QUEUE_DEFERRED, NULL) == SS_ERR_NULL_PARAM);
+
+#if SS_ENABLE_MEMORY_STATS
+    ss_memory_stats_t mem;
+    assert(ss_get_memory_stats(&mem) == SS_OK);
+    assert(mem.queue_bytes > 0);
+#endif
+
+    ss_cleanup();
+    free(qs);
+    printf("Queue telemetry tests passed!\n");
+}
+#endif
+
+#if SS_ENABLE_MEMORY_STATS
+void test_alloc_accounting(void) {
+    printf("\n=== Testing Allocation Accounting ===\n");
+
+    ss_memory_stats_t before, after;
+    ss_connection_t handle;
+    int counter = 0;
+
+    assert(ss_init() == SS_OK);
+    assert(ss_get_memory_stats(&before) == SS_OK);
+
+    assert(ss_signal_register_ex("acct_signal", "desc", SS_PRIORITY_NORMAL) == SS_OK);
+    assert(ss_connect("acct_signal", test_slot_void, &counter) == SS_OK);
+    assert(ss_connect("acct_signal", test_slot_void, &counter) == SS_OK);
+    assert(ss_connect_ex("acct_signal", test_slot_void, &counter,
+                         SS_PRIORITY_HIGH, &handle) == SS_OK);
+    assert(ss_get_memory_stats(&after) == SS_OK);
+    assert(after.signals_used == before.signals_used + 1);
+    assert(after.slots_used == before.slots_used + 3);
+    assert(after.categories[SS_ALLOC_SIGNALS].live_count ==
+           before.categories[SS_ALLOC_SIGNALS].live_count + 1);
+    assert(after.categories[SS_ALLOC_SLOTS].live_count ==
+           before.categories[SS_ALLOC_SLOTS].live_count + 3);
+#if SS_USE_STATIC_MEMORY
+    assert(after.string_bytes == before.string_bytes + sizeof("desc"));
+#else
+    assert(after.string_bytes ==
+           before.string_bytes + sizeof("acct_signal") + sizeof("desc"));
+    assert(after.total_bytes_allocated > before.total_bytes_allocated);
+    assert(after.signals_allocated == before.signals_allocated + 1);
+#endif
+
+    /* slots_used follows disconnects, not just connects */
+    assert(ss_disconnect_handle(handle) == SS_OK);
+    assert(ss_get_memory_stats(&after) == SS_OK);
+    assert(after.slots_used == before.slots_used + 2);
+    assert(after.categories[SS_ALLOC_SLOTS].live_count ==
+           before.categories[SS_ALLOC_SLOTS].live_count + 2);
+
+    /* Payload copies are released by their owners */
+    ss_data_t* data = ss_data_create(SS_TYPE_STRING);
+    assert(data != NULL);
+    assert(ss_data_set_string(data, "hello") == SS_OK);
+    assert(ss_get_memory_stats(&after) == SS_OK);
+    assert(after.categories[SS_ALLOC_PAYLOADS].live_bytes ==
+           before.categories[SS_ALLOC_PAYLOADS].live_bytes +
+           sizeof(ss_data_t) + sizeof("hello"));
+    ss_data_destroy(data);
+    assert(ss_get_memory_stats(&after) == SS_OK);
+    assert(after.categories[SS_ALLOC_PAYLOADS].live_bytes ==
+           before.categories[SS_ALLOC_PAYLOADS].live_bytes);
+    assert(after.categories[SS_ALLOC_PAYLOADS].peak_bytes >=
+           sizeof(ss_data_t) + sizeof("hello"));
+
+    /* Reset restarts peaks and counts but keeps live usage */
+    ss_reset_memory_stats();
+    assert(ss_get_memory_stats(&after) == SS_OK);
+    assert(after.slots_used == before.slots_used + 2);
+    assert(after.peak_bytes_allocated == after.categories[0].live_bytes +
+           after.categories[1].live_bytes + after.categories[2].live_bytes +
+           after.categories[3].live_bytes + after.categories[4].live_bytes +
+           after.categories[5].live_bytes);
+    assert(after.categories[SS_ALLOC_PAYLOADS].total_count == 0);
+
+    assert(ss_signal_unregister("acct_signal") == SS_OK);
+    assert(ss_get_memory_stats(&after) == SS_OK);
+    assert(after.signals_used == before.signals_used);
+    assert(after.slots_used == before.slots_used);
+    assert(after.categories[SS_ALLOC_SLOTS].live_bytes ==
+           before.categories[SS_ALLOC_SLOTS].live_bytes);
+    assert(after.string_bytes == before.string_bytes);
+
+#if SS_ENABLE_ALLOC_HISTOGRAM
+    data = ss_data_create(SS_TYPE_INT);
+    assert(ss_get_memory_stats(&after) == SS_OK);
+    uint64_t classes = 0;
+    for (int i = 0; i < SS_ALLOC_SIZE_CLASSES; i++) classes += after.size_classes[i];
+    assert(classes >= 1);
+    ss_data_destroy(data);
+#endif
+
+    ss_cleanup();
+    printf("Allocation accounting tests passed!\n");
+}
+#endif
+
+#if SS_ENABLE_HOOKS
+typedef struct {
+    int emit_pre;
+    int emit_post;
+    int slot_pre;
+    int slot_post;
+    uint32_t signal_id;
+    ss_slot_func_t last_slot;
+    uint64_t emit_elapsed_ns;
+    uint64_t slot_elapsed_ns;
+} hook_log_t;
+
+static void hook_emit_pre(const ss_hook_info_t* info, void* ctx) {
+    hook_log_t* log = (hook_log_t*)ctx;
+    assert(info->slot == NULL && info->elapsed_ns == 0);
+    log->signal_id = info->signal_id;
+    log->emit_pre++;
+}
+
+static void hook_emit_post(const ss_hook_info_t* info, void* ctx) {
+    hook_log_t* log = (hook_log_t*)ctx;
+    assert(info->signal_id == log->signal_id);
+    assert(strcmp(info->signal_name, "hooked") == 0);
+    log->emit_elapsed_ns = info->elapsed_ns;
+    log->emit_post++;
+}
+
+static void hook_slot_pre(const ss_hook_info_t* info, void* ctx) {
+    hook_log_t* log = (hook_log_t*)ctx;
+    assert(info->slot != NULL && info->data->type == SS_TYPE_INT);
+    log->slot_pre++;
+}
+
+static void hook_slot_post(const ss_hook_info_t* info, void* ctx) {
+    hook_log_t* log = (hook_log_t*)ctx;
+    log->last_slot = info->slot;
+    if (info->elapsed_ns > log->slot_elapsed_ns) {
+        log->slot_elapsed_ns = info->elapsed_ns;
+    }
+    log->slot_post++;
+}
+
+void test_emit_hooks(void) {
+    printf("\n=== Testing Emission Hooks ===\n");
+
+    hook_log_t log;
+    memset(&log, 0, sizeof(log));
+
+    assert(ss_set_emit_hooks(hook_emit_pre, hook_emit_post, &log) == SS_ERR_NULL_PARAM);
+    assert(ss_init() == SS_OK);
+    assert(ss_signal_register("hooked") == SS_OK);
+    assert(ss_connect("hooked", test_slot_int, NULL) == SS_OK);
+    assert(ss_connect_ex("hooked", test_slot_int, NULL, SS_PRIORITY_HIGH, NULL) == SS_OK);
+
+    assert(ss_set_emit_hooks(hook_emit_pre, hook_emit_post, &log) == SS_OK);
+    assert(ss_set_slot_hooks(hook_slot_pre, hook_slot_post, &log) == SS_OK);
+    assert(ss_emit_int("hooked", 1) == SS_OK);
+    assert(log.emit_pre == 1 && log.emit_post == 1);
+    assert(log.slot_pre == 2 && log.slot_post == 2);
+    assert(log.signal_id != 0);
+    assert(log.last_slot == test_slot_int);
+    assert(log.emit_elapsed_ns >= log.slot_elapsed_ns);
+
+    /* Unknown signals never reach the hooks */
+    assert(ss_emit_int("not_registered", 1) == SS_ERR_NOT_FOUND);
+    assert(log.emit_pre == 1);
+
+    /* Re-registering gives a new id */
+    uint32_t old_id = log.signal_id;
+    assert(ss_signal_unregister("hooked") == SS_OK);
+    assert(ss_signal_register("hooked") == SS_OK);
+    assert(ss_emit_int("hooked", 1) == SS_OK);
+    assert(log.emit_pre == 2 && log.slot_pre == 2);
+    assert(log.signal_id != old_id);
+
+    /* Removing the hooks stops the calls */
+    assert(ss_set_emit_hooks(NULL, NULL, NULL) == SS_OK);
+    assert(ss_set_slot_hooks(NULL, NULL, NULL) == SS_OK);
+    assert(ss_connect("hooked", test_slot_int, NULL) == SS_OK);
+    assert(ss_emit_int("hooked", 1) == SS_OK);
+    assert(log.emit_pre == 2 && log.emit_post == 2 && log.slot_post == 2);
+
+    ss_cleanup();
+    printf("Emission hook tests passed!\n");
+}
+#endif
+
+#if SS_ENABLE_HOT_SIGNALS
+static void slow_slot(const ss_data_t* data, void* user_data) {
+    (void)data;
+    (void)user_data;
+    uint64_t until = ss_clock_now_ns() + 200000;
+    while (ss_clock_now_ns() < until) {
+    }
+}
+
+void test_hot_signals(void) {
+    printf("\n=== Testing Hot Signals ===\n");
+
+    ss_hot_signal_t hot[4];
+    size_t count = 0;
+    char name[32];
+    int i, counter = 0;
+#if SS_USE_STATIC_MEMORY
+    const int cold_signals = 20;
+#else
+    const int cold_signals = 3 * SS_HOT_SIGNALS_CAPACITY;
+#endif
+
+    assert(ss_init() == SS_OK);
+    assert(ss_signal_register("hot_a") == SS_OK);
+    assert(ss_signal_register("hot_b") == SS_OK);
+    assert(ss_signal_register("slow") == SS_OK);
+    assert(ss_connect("hot_a", test_slot_void, &counter) == SS_OK);
+    assert(ss_connect("slow", slow_slot, NULL) == SS_OK);
+
+    /* Disabled by default: nothing is tracked */
+    assert(ss_emit_void("hot_a") == SS_OK);
+    assert(ss_get_hot_signals(SS_HOT_BY_EMISSIONS, 4, hot, &count) == SS_OK);
+    assert(count == 0);
+
+    assert(ss_enable_hot_signals(1) == SS_OK);
+    for (i = 0; i < cold_signals; i++) {
+        snprintf(name, sizeof(name), "cold_%d", i);
+        assert(ss_signal_register(name) == SS_OK);
+        assert(ss_emit_void(name) == SS_OK);
+    }
+    for (i = 0; i < 500; i++) assert(ss_emit_void("hot_a") == SS_OK);
+    for (i = 0; i < 200; i++) assert(ss_emit_void("hot_b") == SS_OK);
+    for (i = 0; i < 5; i++) assert(ss_emit_void("slow") == SS_OK);
+
+    assert(ss_get_hot_signals(SS_HOT_BY_EMISSIONS, 2, hot, &count) == SS_OK);
+    assert(count == 2);
+    assert(strcmp(hot[0].name, "hot_a") == 0);
+    assert(strcmp(hot[1].name, "hot_b") == 0);
+    assert(hot[0].emissions >= hot[1].emissions);
+    assert(hot[0].emissions - hot[0].emissions_error <= 500);
+
+    assert(ss_get_hot_signals(SS_HOT_BY_TIME, 1, hot, &count) == SS_OK);
+    assert(count == 1);
+    assert(strcmp(hot[0].name, "slow") == 0);
+    assert(hot[0].time_ns >= 5 * 200000ULL / 2);
+
+    assert(ss_get_hot_signals((ss_hot_metric_t)7, 1, hot, &count) == SS_ERR_INVALID_TYPE);
+
+    /* Unregistered signals drop out of the report */
+    assert(ss_signal_unregister("hot_a") == SS_OK);
+    assert(ss_get_hot_signals(SS_HOT_BY_EMISSIONS, 1, hot, &count) == SS_OK);
+    assert(count == 1 && strcmp(hot[0].name, "hot_b") == 0);
+
+    ss_reset_hot_signals();
+    assert(ss_get_hot_signals(SS_HOT_BY_TIME, 4, hot, &count) == SS_OK);
+    assert(count == 0);
+
+    ss_cleanup();
+    printf("Hot signal tests passed!\n");
+}
+#endif
+
+#if SS_ENABLE_WASTE_STATS
+/* Removes every slot, then re-emits while they are still pending removal */
+static void disconnect_all_and_reemit(const ss_data_t* data, void* user_data) {
+    (void)data;
+    (void)user_data;
+    ss_disconnect_all("stale");
+    ss_emit_void("stale");
+}
+
+void test_waste_stats(void) {
+    printf("\n=== Testing Waste Statistics ===\n");
+
+    ss_waste_stats_t report[2];
+    ss_waste_stats_t w;
+    size_t count = 0;
+    char last[32];
+    int i, counter = 0;
+
+    assert(ss_init() == SS_OK);
+    assert(ss_signal_register("unused") == SS_OK);
+    assert(ss_signal_register("fanout") == SS_OK);
+    assert(ss_signal_register("stale") == SS_OK);
+    for (i = 0; i < 5; i++) {
+        assert(ss_connect("fanout", test_slot_void, &counter) == SS_OK);
+    }
+    assert(ss_connect("stale", disconnect_all_and_reemit, NULL) == SS_OK);
+
+    for (i = 0; i < 3; i++) assert(ss_emit_void("unused") == SS_OK);
+    assert(ss_emit_void("fanout") == SS_OK);
+    assert(ss_emit_void("stale") == SS_OK);
+    assert(ss_emit_void("stale") == SS_OK);
+
+    assert(ss_get_waste_stats("fanout", &w) == SS_OK);
+    assert(w.emissions == 1 && w.wasted_emissions == 0);
+    assert(w.slot_calls == 5);
+    assert(w.fanout[3] == 1);   /* 4..7 slots */
+
+    assert(ss_get_waste_stats("unused", &w) == SS_OK);
+    assert(w.zero_slot_emissions == 3 && w.fanout[0] == 3);
+
+    /* Outer call ran one slot, nested call found it removed, last found none */
+    assert(ss_get_waste_stats("stale", &w) == SS_OK);
+    assert(w.emissions == 3 && w.slot_calls == 1);
+    assert(w.all_removed_emissions == 1 && w.zero_slot_emissions == 1);
+    assert(w.fanout[1] == 1 && w.fanout[0] == 2);
+
+    assert(ss_get_waste_stats("nope", &w) == SS_ERR_NOT_FOUND);
+
+    /* Ranked by wasted emissions, clipped to the buffer */
+    assert(ss_get_waste_report(report, 2, &count) == SS_OK);
+    assert(count == 2);
+    assert(strcmp(report[0].name, "unused") == 0);
+    assert(strcmp(report[1].name, "stale") == 0);
+    assert(ss_get_waste_report(report, 1, &count) == SS_OK);
+    assert(count == 1 && strcmp(report[0].name, "unused") == 0);
+
+    assert(ss_emit_void("missing_signal") == SS_ERR_NOT_FOUND);
+    assert(ss_emit_void("missing_signal") == SS_ERR_NOT_FOUND);
+    assert(ss_get_not_found_emissions(last, sizeof(last)) == 2);
+    assert(strcmp(last, "missing_signal") == 0);
+
+    ss_reset_waste_stats();
+    assert(ss_get_not_found_emissions(NULL, 0) == 0);
+    assert(ss_get_waste_report(report, 2, &count) == SS_OK && count == 0);
+
+    ss_cleanup();
+    printf("Waste statistics tests passed!\n");
+}
+#endif
+
+#if SS_ENABLE_CALL_GRAPH
+static void cascade_to_b(const ss_data_t* data, void* user_data) {
+    (void)data;
+    (void)user_data;
+    ss_emit_void("cg_b");
+}
+
+static void cascade_to_c(const ss_data_t* data, void* user_data) {
+    (void)data;
+    (void)user_data;
+    ss_emit_void("cg_c");
+}
+
+void test_call_graph(void) {
+    printf("\n=== Testing Call Graph ===\n");
+
+    char buf[1024];
+    size_t written = 0;
+    int counter = 0;
+
+    assert(ss_init() == SS_OK);
+    /* Nested emits must not deadlock with locking on */
+    ss_set_thread_safe(1);
+    assert(ss_signal_register("cg_a") == SS_OK);
+    assert(ss_signal_register("cg_b") == SS_OK);
+    assert(ss_signal_register("cg_c") == SS_OK);
+    assert(ss_connect("cg_a", cascade_to_b, NULL) == SS_OK);
+    assert(ss_connect("cg_b", cascade_to_c, NULL) == SS_OK);
+    assert(ss_connect("cg_c", test_slot_void, &counter) == SS_OK);
+
+    /* Nothing recorded until enabled */
+    assert(ss_emit_void("cg_a") == SS_OK);
+    assert(ss_call_graph_write(buf, sizeof(buf), SS_FMT_JSON, &written) == SS_OK);
+    assert(strstr(buf, "\"edges\":[]") != NULL);
+
+    assert(ss_enable_call_graph(1) == SS_OK);
+    assert(ss_emit_void("cg_a") == SS_OK);
+    assert(ss_emit_void("cg_a") == SS_OK);
+    assert(ss_emit_void("cg_c") == SS_OK);
+    assert(counter == 4);
+
+    assert(ss_call_graph_write(buf, sizeof(buf), SS_FMT_JSON, &written) == SS_OK);
+    assert(written == strlen(buf));
+    assert(strstr(buf, "{\"parent\":null,\"child\":\"cg_a\",\"count\":2,") != NULL);
+    assert(strstr(buf, "{\"parent\":\"cg_a\",\"child\":\"cg_b\",\"count\":2,") != NULL);
+    assert(strstr(buf, "{\"parent\":\"cg_b\",\"child\":\"cg_c\",\"count\":2,") != NULL);
+    assert(strstr(buf, "{\"parent\":null,\"child\":\"cg_c\",\"count\":1,") != NULL);
+    assert(strstr(buf, "\"dropped_edges\":0,\"truncated_depth\":0") != NULL);
+
+    assert(ss_call_graph_write(buf, sizeof(buf), SS_FMT_DOT, &written) == SS_OK);
+    assert(strncmp(buf, "digraph ss_calls {", 18) == 0);
+    assert(strstr(buf, "\"cg_a\" -> \"cg_b\" [label=\"2 calls") != NULL);
+
+    /* Size query and unsupported format */
+    assert(ss_call_graph_write(NULL, 0, SS_FMT_DOT, &written) == SS_ERR_BUFFER_TOO_SMALL);
+    assert(written > 0);
+    assert(ss_call_graph_write(buf, sizeof(buf), SS_FMT_PROMETHEUS, NULL) == SS_ERR_UNSUPPORTED);
+
+    ss_reset_call_graph();
+    assert(ss_call_graph_write(buf, sizeof(buf), SS_FMT_JSON, NULL) == SS_OK);
+    assert(strstr(buf, "\"edges\":[]") != NULL);
+
+    ss_cleanup();
+    printf("Call graph tests passed!\n");
+}
+#endif
+
+#if SS_ENABLE_INTROSPECTION
+static int count_signal_view(const ss_signal_view_t* view, void* ctx) {
+    size_t* slots = (size_t*)ctx;
+    assert(view->name != NULL && view->id != 0);
+    slots[0]++;
+    slots[1] += view->slot_count;
+    return 0;
+}
+
+static int stop_after_first(const ss_signal_view_t* view, void* ctx) {
+    (void)view;
+    (*(int*)ctx)++;
+    return 1;
+}
+
+static int collect_slot_priority(const ss_slot_view_t* view, void* ctx) {
+    ss_priority_t* out = (ss_priority_t*)ctx;
+    assert(view->func == test_slot_void && view->handle != 0);
+    out[0] = view->priority;
+    return 1;
+}
+
+void test_introspection_iterators(void) {
+    printf("\n=== Testing Introspection Iterators ===\n");
+
+    ss_signal_iter_t it;
+    ss_signal_view_t view;
+    ss_connection_t handle;
+    ss_priority_t first = SS_PRIORITY_LOW;
+    size_t totals[2] = {0, 0};
+    int seen[4] = {0, 0, 0, 0};
+    int visits = 0, counter = 0;
+
+    assert(ss_init() == SS_OK);
+    assert(ss_signal_register_ex("it_0", "first", SS_PRIORITY_HIGH) == SS_OK);
+    assert(ss_signal_register("it_1") == SS_OK);
+    assert(ss_signal_register("it_2") == SS_OK);
+    assert(ss_signal_register("it_3") == SS_OK);
+    assert(ss_connect_ex("it_1", test_slot_void, &counter, SS_PRIORITY_HIGH,
+                         &handle) == SS_OK);
+    assert(ss_connect("it_1", test_slot_void, &counter) == SS_OK);
+    assert(ss_connect("it_2", test_slot_void, &counter) == SS_OK);
+
+#if SS_ENABLE_MEMORY_STATS
+    ss_memory_stats_t before, after;
+    assert(ss_get_memory_stats(&before) == SS_OK);
+#endif
+
+    assert(ss_foreach_signal(count_signal_view, totals) == SS_OK);
+    assert(totals[0] == 4 && totals[1] == 3);
+    assert(ss_foreach_signal(stop_after_first, &visits) == SS_OK);
+    assert(visits == 1);
+
+    /* Highest priority first; disconnected slots are skipped */
+    assert(ss_foreach_slot("it_1", collect_slot_priority, &first) == SS_OK);
+    assert(first == SS_PRIORITY_HIGH);
+    assert(ss_disconnect_handle(handle) == SS_OK);
+    assert(ss_foreach_slot("it_1", collect_slot_priority, &first) == SS_OK);
+    assert(first == SS_PRIORITY_NORMAL);
+    assert(ss_foreach_slot("missing", collect_slot_priority, &first) == SS_ERR_NOT_FOUND);
+
+#if SS_ENABLE_MEMORY_STATS
+    assert(ss_get_memory_stats(&after) == SS_OK);
+    assert(after.categories[SS_ALLOC_OTHER].total_count ==
+           before.categories[SS_ALLOC_OTHER].total_count);
+#endif
+
+    /* Registry changes between steps neither repeat nor skip survivors */
+    ss_signal_iter_init(&it);
+    assert(ss_signal_iter_next(&it, &view) == SS_OK);
+    seen[view.name[3] - '0']++;
+    assert(view.description == NULL);
+    assert(ss_signal_unregister(view.name) == SS_OK);
+    assert(ss_signal_register("it_new") == SS_OK);
+    while (ss_signal_iter_next(&it, &view) == SS_OK) {
+        if (strcmp(view.name, "it_new") == 0) continue;
+        seen[view.name[3] - '0']++;
+    }
+    assert(seen[0] == 1 && seen[1] == 1 && seen[2] == 1 && seen[3] == 1);
+    assert(ss_signal_iter_next(&it, &view) == SS_ERR_NOT_FOUND);
+
+    ss_cleanup();
+    printf("Introspection iterator tests passed!\n");
+}
+#endif
+
+#if SS_ENABLE_THREAD_STATS
+#if SS_ENABLE_THREAD_SAFETY && !defined(_WIN32)
+static void* thread_stats_worker(void* arg) {
+    assert(ss_set_thread_name((const char*)arg) == SS_OK);
+    assert(ss_emit_void("ts_a") == SS_OK);
+    return NULL;
+}
+#endif
+
+void test_thread_stats(void) {
+    printf("\n=== Testing Thread Statistics ===\n");
+
+    ss_thread_stats_t stats[SS_MAX_THREAD_STATS];
+    size_t count = 0;
+    int counter = 0;
+
+    assert(ss_init() == SS_OK);
+    assert(ss_signal_register("ts_a") == SS_OK);
+    assert(ss_connect("ts_a", test_slot_void, &counter) == SS_OK);
+    assert(ss_connect("ts_a", test_slot_void, &counter) == SS_OK);
+
+    /* Nothing is counted until enabled */
+    assert(ss_emit_void("ts_a") == SS_OK);
+    assert(ss_get_thread_stats(stats, SS_MAX_THREAD_STATS, &count) == SS_OK);
+    assert(count == 0);
+
+    assert(ss_enable_thread_stats(1) == SS_OK);
+    assert(ss_set_thread_name("main") == SS_OK);
+    assert(ss_emit_void("ts_a") == SS_OK);
+    assert(ss_emit_void("ts_a") == SS_OK);
+    assert(ss_emit_deferred("ts_a", NULL) == SS_OK);
+    assert(ss_flush_deferred() == SS_OK);
+
+    assert(ss_get_thread_stats(stats, SS_MAX_THREAD_STATS, &count) == SS_OK);
+    assert(count == 1);
+    assert(strcmp(stats[0].name, "main") == 0 && stats[0].thread_id != 0);
+    assert(stats[0].emissions == 3 && stats[0].slot_calls == 6);
+    assert(stats[0].deferred_enqueues == 1);
+    assert(stats[0].lock_waits == 0);
+    assert(ss_get_thread_stats(stats, 0, &count) == SS_OK && count == 0);
+
+    /* Blocks and names survive a reset and a new context */
+    ss_reset_thread_stats();
+    ss_cleanup();
+    assert(ss_init() == SS_OK);
+    assert(ss_get_thread_stats(stats, SS_MAX_THREAD_STATS, &count) == SS_OK);
+    assert(count == 1 && stats[0].emissions == 0);
+    assert(strcmp(stats[0].name, "main") == 0);
+
+#if SS_ENABLE_THREAD_SAFETY && !defined(_WIN32)
+    /* Exited threads return their blocks: more threads than the pool holds,
+     * one at a time, never spill into the shared block */
+    {
+        char names[SS_MAX_THREAD_STATS + 4][SS_THREAD_NAME_LENGTH];
+        size_t i, j;
+
+        assert(ss_signal_register("ts_a") == SS_OK);
+        assert(ss_enable_thread_stats(1) == SS_OK);
+        for (i = 0; i < SS_MAX_THREAD_STATS + 4; i++) {
+            pthread_t t;
+            snprintf(names[i], sizeof(names[i]), "w%u", (unsigned)i);
+            assert(pthread_create(&t, NULL, thread_stats_worker, names[i]) == 0);
+            assert(pthread_join(t, NULL) == 0);
+        }
+        assert(ss_get_thread_stats(stats, SS_MAX_THREAD_STATS, &count) == SS_OK);
+        for (j = 0; j < count; j++) {
+            assert(strcmp(stats[j].name, "(overflow)") != 0);
+        }
+        /* The last worker's block is kept, cleared of its predecessor */
+        for (j = 0; j < count; j++) {
+            if (strcmp(stats[j].name, names[SS_MAX_THREAD_STATS + 3]) == 0) break;
+        }
+        assert(j < count && stats[j].emissions == 1);
+    }
+#endif
+
+    ss_cleanup();
+    printf("Thread statistics tests passed!\n");
+}
+#endif
+
 int main(void) {
     printf("Starting Signal-Slot Library Tests\n");
     printf("==================================\n");
@@ -510,10 +1552,46 @@ int main(void) {
     test_thread_safety_config();
     test_namespace();
     test_deferred_emission();
+    test_deferred_reentrant();
     test_batch_operations();
 #if SS_ENABLE_ISR_SAFE
     test_isr_null_signal();
 #endif
+#if SS_ENABLE_PERFORMANCE_STATS
+    test_profiling_clock();
+    test_sampled_profiling();
+    test_perf_histogram();
+#endif
+#if SS_ENABLE_TRACE_BUFFER
+    test_trace_buffer_export();
+#endif
+#if SS_ENABLE_INTROSPECTION
+    test_metrics_export();
+#endif
+#if SS_ENABLE_QUEUE_STATS
+    test_queue_stats();
+#endif
+#if SS_ENABLE_MEMORY_STATS
+    test_alloc_accounting();
+#endif
+#if SS_ENABLE_HOOKS
+    test_emit_hooks();
+#endif
+#if SS_ENABLE_HOT_SIGNALS
+    test_hot_signals();
+#endif
+#if SS_ENABLE_WASTE_STATS
+    test_waste_stats();
+#endif
+#if SS_ENABLE_CALL_GRAPH
+    test_call_graph();
+#endif
+#if SS_ENABLE_INTROSPECTION
+    test_introspection_iterators();
+#endif
+#if SS_ENABLE_THREAD_STATS
+    test_thread_stats();
+#endif
 
     printf("\n==================================\n");
     printf("All tests passed successfully!\n");